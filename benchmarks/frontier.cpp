@@ -0,0 +1,183 @@
+/*
+    frontier.cpp: Compare frontier implementations on synthetic workloads.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* Each workload drives the frontier through the same calls that
+ * best_first_search makes (push, top/pop and detail::handle_child), so the
+ * numbers reflect what the search engine would see.
+ *
+ * 	push-pop:	push n distinct states with random costs, then pop them all.
+ * 	decrease:	push n states, offer 4n random cheaper or dearer duplicates, pop all.
+ * 	mixed:		pop one, generate b children over a 4n state space, until empty.
+ */
+
+#include "bestfirstsearch.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <boost/heap/d_ary_heap.hpp>
+
+using namespace std;
+using namespace jsearch;
+
+
+struct Synthetic
+{
+	typedef unsigned state;
+	typedef unsigned action;
+	typedef unsigned cost;
+	typedef unsigned pathcost;
+	typedef std::shared_ptr<DefaultNode<Synthetic>> node;
+};
+
+typedef Synthetic::node Node;
+
+template <typename Traits>
+using Comparator = SimpleComparator<Traits>;
+
+template <typename Key, typename Value>
+using Map = unordered_map<Key, Value>;
+
+template <size_t Arity>
+struct boost_d_ary
+{
+	typedef queue_set<boost::heap::d_ary_heap<Node, boost::heap::mutable_<true>, boost::heap::arity<Arity>, boost::heap::compare<Comparator<Synthetic>>>, Map> type;
+};
+
+template <size_t Arity>
+struct indexed
+{
+	typedef queue_set<indexed_d_ary_heap<Node, Comparator<Synthetic>, Arity>, Map> type;
+};
+
+
+Node make(unsigned const STATE, unsigned const COST)
+{
+	return make_shared<Node::element_type>(STATE, Node(), 0, COST);
+}
+
+
+template <class Frontier>
+void push_pop(size_t const N, mt19937 engine)
+{
+	Frontier frontier;
+	uniform_int_distribution<unsigned> cost(0, 1000000);
+
+	for(unsigned i(0); i < N; ++i)
+		frontier.push(make(i, cost(engine)));
+
+	while(!frontier.empty())
+		detail::pop(frontier);
+}
+
+
+template <class Frontier>
+void decrease(size_t const N, mt19937 engine)
+{
+	Frontier frontier;
+	uniform_int_distribution<unsigned> cost(0, 1000000), state(0, N - 1);
+
+	for(unsigned i(0); i < N; ++i)
+		frontier.push(make(i, cost(engine)));
+
+	for(size_t i(0); i < 4 * N; ++i)
+		detail::handle_child(frontier, make(state(engine), cost(engine)), detail::trace_evaluation<Comparator<Synthetic>>());
+
+	while(!frontier.empty())
+		detail::pop(frontier);
+}
+
+
+template <class Frontier>
+void mixed(size_t const N, mt19937 engine)
+{
+	Frontier frontier;
+	unordered_set<unsigned> closed;
+	uniform_int_distribution<unsigned> step(1, 500), state(0, 4 * N - 1);
+
+	frontier.push(make(0, 0));
+
+	while(!frontier.empty())
+	{
+		auto const S(detail::pop(frontier));
+		closed.insert(S->state());
+
+		for(unsigned i(0); i < 8; ++i)
+		{
+			auto const SUCCESSOR(state(engine));
+			if(closed.find(SUCCESSOR) == end(closed))
+				detail::handle_child(frontier, make(SUCCESSOR, S->path_cost() + step(engine)), detail::trace_evaluation<Comparator<Synthetic>>());
+		}
+	}
+}
+
+
+template <class Frontier>
+void run(string const &NAME, size_t const N, mt19937::result_type const SEED)
+{
+	cout << left << setw(20) << NAME << right;
+
+	auto time = [&](void (*workload)(size_t, mt19937))
+	{
+		auto const T0(chrono::steady_clock::now());
+		workload(N, mt19937(SEED));
+		auto const ELAPSED(chrono::steady_clock::now() - T0);
+		cout << setw(12) << chrono::duration_cast<chrono::microseconds>(ELAPSED).count();
+	};
+
+	time(push_pop<Frontier>);
+	time(decrease<Frontier>);
+	time(mixed<Frontier>);
+	cout << "\n";
+}
+
+
+int main(int argc, char **argv)
+{
+	size_t n(100000);
+	mt19937::result_type seed(0);
+
+	switch(argc)
+	{
+		case 3:
+			istringstream(argv[2]) >> seed;
+		case 2:
+			istringstream(argv[1]) >> n;
+		case 1:
+		case 0:
+			break;
+
+		default:
+			cerr << "Invocation: frontier [n] [seed]\n";
+			exit(EXIT_FAILURE);
+			break;
+	}
+
+	cout << "n: " << n << ", seed: " << seed << " (times in µs)\n";
+	cout << left << setw(20) << "frontier" << right << setw(12) << "push-pop" << setw(12) << "decrease" << setw(12) << "mixed" << "\n";
+	run<boost_d_ary<2>::type>("queue_set d_ary<2>", n, seed);
+	run<boost_d_ary<4>::type>("queue_set d_ary<4>", n, seed);
+	run<indexed<2>::type>("indexed<2>", n, seed);
+	run<indexed<4>::type>("indexed<4>", n, seed);
+	run<indexed<8>::type>("indexed<8>", n, seed);
+}
@@ -0,0 +1,328 @@
+/*
+    queues.cpp: Compare priority queues as the frontier of whole searches.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* Where frontier.cpp drives the frontiers with synthetic workloads, this runs
+ * best_first_search itself on the example domains with each PriorityQueue:
+ *
+ * 	15-puzzle:	A* with Manhattan distance on the first instances of puzzle15.txt.
+ * 	grid:		A* with octile distance on the rooms256 scenarios.
+ * 	random:		Dijkstra on a random graph of 1,000,000 vertices, branching factor 4,
+ * 			to 500,000 expansions.
+ *
+ * For each it reports the time, the number of comparator calls, the number of
+ * pushes and of decrease-keys, and the expansions, which differ between queues
+ * only by how they order ties.  boost::heap::priority_queue is not mutable, so
+ * it cannot be a frontier.  The (f, h) buckets need integer costs, so they are
+ * measured on the 15-puzzle only, and make no comparisons.
+ */
+
+// For the push and decrease-key counts in stats.
+#define STATISTICS
+
+#include "puzzle.hpp"
+#include "grid.hpp"
+#include "movingai.hpp"
+#include "random.hpp"
+#include "gg.hpp"
+#include "bestfirstsearch.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+#include <unordered_map>
+#include <unordered_set>
+#include <boost/heap/d_ary_heap.hpp>
+#include <boost/heap/pairing_heap.hpp>
+#include <boost/heap/binomial_heap.hpp>
+#include <boost/heap/fibonacci_heap.hpp>
+#include <boost/heap/skew_heap.hpp>
+
+using namespace std;
+using namespace jsearch;
+
+
+template <typename T, typename Comparator>
+using DAry2 = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>, boost::heap::arity<2>, boost::heap::compare<Comparator>>;
+
+template <typename T, typename Comparator>
+using DAry4 = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>, boost::heap::arity<4>, boost::heap::compare<Comparator>>;
+
+template <typename T, typename Comparator>
+using DAry8 = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>, boost::heap::arity<8>, boost::heap::compare<Comparator>>;
+
+template <typename T, typename Comparator>
+using Pairing = boost::heap::pairing_heap<T, boost::heap::compare<Comparator>>;
+
+template <typename T, typename Comparator>
+using Binomial = boost::heap::binomial_heap<T, boost::heap::compare<Comparator>>;
+
+template <typename T, typename Comparator>
+using Fibonacci = boost::heap::fibonacci_heap<T, boost::heap::compare<Comparator>>;
+
+template <typename T, typename Comparator>
+using Skew = boost::heap::skew_heap<T, boost::heap::mutable_<true>, boost::heap::compare<Comparator>>;
+
+template <typename T, typename Comparator>
+using Indexed2 = indexed_d_ary_heap<T, Comparator, 2>;
+
+template <typename T, typename Comparator>
+using Indexed4 = indexed_d_ary_heap<T, Comparator, 4>;
+
+template <typename T, typename Comparator>
+using Buckets = bucket_queue<T, Comparator>;
+
+
+// The heaps copy their comparator, so the count is kept outside it.
+size_t comparisons;
+
+template <typename Traits, template <typename Traits_> class Comparator>
+class Counting : public Comparator<Traits>
+{
+public:
+	typedef typename Traits::node Node;
+
+	bool operator()(Node const &A, Node const &B) const
+	{
+		++comparisons;
+		return Comparator<Traits>::operator()(A, B);
+	}
+};
+
+
+namespace jsearch
+{
+	// The buckets take f and h from the comparator's policies and never call it.
+	template <typename T, typename Traits, template <typename Traits_> class Comparator, template <typename Key, typename Value> class Map>
+	class queue_set<bucket_queue<T, Counting<Traits, Comparator>>, Map> : public queue_set<bucket_queue<T, Comparator<Traits>>, Map>
+	{
+	};
+}
+
+
+template <typename Key, typename Value>
+using HashMap = std::unordered_map<Key, Value>;
+
+template <typename T>
+using HashSet = std::unordered_set<T>;
+
+
+/*************
+ * 15-puzzle *
+ *************/
+template <typename Traits>
+using PuzzleCost = AStar<Traits, Manhattan>;
+
+template <typename Traits>
+using PuzzleTies = LowH<Traits, Manhattan>;
+
+template <typename Traits>
+using PuzzleOrder = TiebreakingComparator<Traits, PuzzleCost, PuzzleTies>;
+
+template <typename Traits>
+using PuzzleComparator = Counting<Traits, PuzzleOrder>;
+
+template <typename Traits, template <typename> class StepCost, template <typename> class Result, template <typename> class Create>
+using ManhattanChild = IncrementalChildPolicy<Traits, Manhattan, StepCost, Result, Create>;
+
+
+struct puzzles
+{
+	static char const *name() { return "15-puzzle"; }
+
+	puzzles(string const &DIRECTORY, size_t const COUNT) : instances(load_puzzles<4>(DIRECTORY + "/puzzle15.txt"))
+	{
+		if(instances.size() > COUNT)
+			instances.resize(COUNT);
+	}
+
+	// The total length of the solutions.
+	template <template <typename T, typename Comparator> class PriorityQueue>
+	double solve() const
+	{
+		double result(0);
+		for(auto const &I : instances)
+		{
+			puzzle_counters const COUNTERS;
+			context<puzzle_counters> const CONTEXT(COUNTERS);
+			Problem<Puzzle<4>, UnitCost, BlankMoves, SlideTile, Solved, DefaultNodeCreator, ManhattanChild> const PROBLEM(I.initial);
+			vector<Puzzle<4>::state> path;
+			result += best_first_search<PriorityQueue, PuzzleComparator, HashSet, HashMap>(PROBLEM, back_inserter(path));
+		}
+		return result;
+	}
+
+	vector<puzzle_instance<4>> instances;
+};
+
+
+/********
+ * Grid *
+ ********/
+template <typename Traits>
+using GridCost = AStar<Traits, Octile>;
+
+template <typename Traits>
+using GridTies = LowH<Traits, Octile>;
+
+template <typename Traits>
+using GridOrder = TiebreakingComparator<Traits, GridCost, GridTies>;
+
+template <typename Traits>
+using GridComparator = Counting<Traits, GridOrder>;
+
+
+struct grids
+{
+	static char const *name() { return "grid"; }
+
+	explicit grids(string const &DIRECTORY) : map(movingai::load_map(DIRECTORY + "/rooms256.map")), scenarios(movingai::load_scenarios(DIRECTORY + "/rooms256.map.scen")) {}
+
+	template <template <typename T, typename Comparator> class PriorityQueue>
+	double solve() const
+	{
+		double result(0);
+		for(auto const &S : scenarios)
+		{
+			grid_instance const INSTANCE(map, map.at(S.goal_x, S.goal_y));
+			context<grid_instance> const CONTEXT(INSTANCE);
+			Problem<Grid, MoveCost, GridMoves, MoveTo, AtGoal> const PROBLEM(grid_state(map.at(S.start_x, S.start_y)));
+			vector<grid_state> path;
+			result += best_first_search<PriorityQueue, GridComparator, HashSet, HashMap>(PROBLEM, back_inserter(path));
+		}
+		return result;
+	}
+
+	grid_map const map;
+	vector<movingai::scenario> const scenarios;
+};
+
+
+/****************
+ * Random graph *
+ ****************/
+template <typename Traits>
+using RandomOrder = SimpleComparator<Traits, Dijkstra>;
+
+template <typename Traits>
+using RandomComparator = Counting<Traits, RandomOrder>;
+
+
+struct random_graph
+{
+	static char const *name() { return "random"; }
+
+	explicit random_graph(mt19937::result_type const SEED) : instance(gg::generate_csr_graph<cost_t>(1000000, 4, mt19937(SEED)), 500000) {}
+
+	template <template <typename T, typename Comparator> class PriorityQueue>
+	double solve() const
+	{
+		context<random_instance> const CONTEXT(instance);
+		Problem<Random, EdgeWeight, OutEdges, EdgeTarget, GoalTest> const PROBLEM(0);
+		vector<Random::state> path;
+		return best_first_search<PriorityQueue, RandomComparator, dense_set, dense_map>(PROBLEM, back_inserter(path));
+	}
+
+	random_instance const instance;
+};
+
+
+template <template <typename T, typename Comparator> class PriorityQueue, class Domain>
+void measure(string const &NAME, Domain const &DOMAIN, double &answer)
+{
+	comparisons = 0;
+	stats = statistics();
+
+	auto const T0(chrono::steady_clock::now());
+	double const RESULT(DOMAIN.template solve<PriorityQueue>());
+	auto const ELAPSED(chrono::duration<double, milli>(chrono::steady_clock::now() - T0).count());
+
+	if(isnan(answer))
+		answer = RESULT;
+	bool const WRONG(abs(RESULT - answer) > 1e-9 * max(1.0, abs(answer)));
+
+	cout << left << setw(14) << NAME << right << setw(10) << fixed << setprecision(1) << ELAPSED << setw(14) << comparisons << setw(12) << stats.pushed << setw(12) << stats.decreased << setw(12) << stats.popped << (WRONG ? "  (different cost!)" : "") << "\n";
+}
+
+
+// Only the 15-puzzle has integer costs, which the buckets need.
+template <class Domain>
+void measure_buckets(Domain const &, double &) {}
+
+void measure_buckets(puzzles const &DOMAIN, double &answer)
+{
+	measure<Buckets>("buckets", DOMAIN, answer);
+}
+
+
+template <class Domain>
+void compare(Domain const &DOMAIN)
+{
+	double answer(NAN);
+	cout << "\n" << DOMAIN.name() << "\n";
+	cout << left << setw(14) << "queue" << right << setw(10) << "ms" << setw(14) << "comparisons" << setw(12) << "pushes" << setw(12) << "decreases" << setw(12) << "expanded" << "\n";
+	measure<DAry2>("d_ary<2>", DOMAIN, answer);
+	measure<DAry4>("d_ary<4>", DOMAIN, answer);
+	measure<DAry8>("d_ary<8>", DOMAIN, answer);
+	measure<Pairing>("pairing", DOMAIN, answer);
+	measure<Binomial>("binomial", DOMAIN, answer);
+	measure<Fibonacci>("fibonacci", DOMAIN, answer);
+	measure<Skew>("skew", DOMAIN, answer);
+	measure<Indexed2>("indexed<2>", DOMAIN, answer);
+	measure<Indexed4>("indexed<4>", DOMAIN, answer);
+	measure_buckets(DOMAIN, answer);
+}
+
+
+int main(int argc, char **argv)
+{
+	size_t puzzles_count(5);
+	mt19937::result_type seed(0);
+
+	switch(argc)
+	{
+		case 4:
+			istringstream(argv[3]) >> seed;
+		case 3:
+			istringstream(argv[2]) >> puzzles_count;
+		case 2:
+			break;
+
+		default:
+			cerr << "Invocation: queues <examples/data directory> [15-puzzle instances] [seed]\n";
+			exit(EXIT_FAILURE);
+			break;
+	}
+
+	try
+	{
+		compare(puzzles(argv[1], puzzles_count));
+		compare(grids(argv[1]));
+		compare(random_graph(seed));
+	}
+	catch(runtime_error const &EX)
+	{
+		cerr << EX.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+}
@@ -28,10 +28,23 @@
 #include "problem.hpp"
 #include "utils/to_string.hpp"
 #include "utils/queue_set.hpp"
+#include "utils/indexed_heap.hpp"
+#include "utils/bucket_queue.hpp"
+#include "utils/closed_list.hpp"
+#include "utils/dense_containers.hpp"
+#include "utils/tracking_allocator.hpp"
+#include "utils/trace.hpp"
+#include "utils/cancellation.hpp"
 
 #include <algorithm>
 #include <stdexcept>
 #include <limits>
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <array>
+#include <functional>
 
 #ifndef NDEBUG
 #include <iostream>
@@ -42,11 +55,12 @@ namespace jsearch
 #ifdef STATISTICS
 	struct statistics
 	{
-		statistics() : popped(0), pushed(0), decreased(0), discarded(0) {}
+		statistics() : popped(0), pushed(0), decreased(0), discarded(0), reopened(0) {}
 		size_t popped;
 		size_t pushed;
 		size_t decreased;
 		size_t discarded;
+		size_t reopened;
 	};
 	
 	statistics stats;
@@ -74,9 +88,11 @@ namespace jsearch
 		* 				i) nullptr if CHILD was not added to the frontier
 		* 				ii) CHILD if CHILD was added to the frontier, or
 		* 				iii) another element if CHILD replaced it on the frontier.
+		*
+		* EVALUATION gives f and h for the trace (see trace_evaluation).
 		* */
-		template <class Frontier>
-        inline typename Frontier::value_type handle_child(Frontier &frontier, typename Frontier::const_reference const &CHILD)
+		template <class Frontier, class Evaluation>
+        inline typename Frontier::value_type handle_child(Frontier &frontier, typename Frontier::const_reference const &CHILD, Evaluation const &EVALUATION)
 		{
             typename Frontier::value_type result(nullptr); // Initialize to nullptr since it might be a bald pointer.
 
@@ -93,6 +109,7 @@ namespace jsearch
 	#ifdef STATISTICS
 					++stats.decreased;
 	#endif
+					detail::trace(trace_event::DECREASE, CHILD, EVALUATION);
                     result = (*DUPLICATE); // Store a copy of the node that we are about to replace.
                     frontier.increase(DUPLICATE, CHILD); // The DECREASE-KEY operation is an increase because it is a max-heap.
                 }
@@ -104,6 +121,7 @@ namespace jsearch
 	#ifdef STATISTICS
 					++stats.discarded;
 	#endif
+					detail::trace(trace_event::DUPLICATE, CHILD, EVALUATION);
 				}
 			}
 			else
@@ -116,10 +134,139 @@ namespace jsearch
 	#ifdef STATISTICS
 				++stats.pushed;
 	#endif
+				detail::trace(trace_event::GENERATE, CHILD, EVALUATION);
 			}
 
             return result;
 		}
+
+
+		/**
+		 * Record that the child of S by ACTION was thrown away because SUCCESSOR is closed.
+		 * The child is only made if there is a trace_recorder to record it.
+		 */
+		template <class Problem, class Node, class Action, class State, class Evaluation>
+		inline void trace_closed(Problem const &PROBLEM, Node const &S, Action const &ACTION, State const &SUCCESSOR, Evaluation const &EVALUATION)
+		{
+			if(context<trace_recorder>::find())
+				trace(trace_event::CLOSED, PROBLEM.child(S, ACTION, SUCCESSOR), EVALUATION);
+		}
+
+
+		/**
+		 * For each of ACTIONS from S, in order, call VISIT with the child if ADMIT(ACTION, SUCCESSOR).
+		 *
+		 * A Problem whose ChildPolicy batches children (see detail::batches_children) is
+		 * asked for all the admitted children at once, and they are visited after every
+		 * action has been admitted or not.  Admission does not depend on the visits, so
+		 * the search is the same; only in a trace do the CLOSED events of an expansion
+		 * come before its other events.
+		 */
+		template <class Problem, class Node, class Actions, class Admit, class Visit>
+		inline void for_each_child(Problem const &PROBLEM, Node const &S, Actions const &ACTIONS, Admit const &ADMIT, Visit const &VISIT)
+		{
+			for_each_child(PROBLEM, S, ACTIONS, ADMIT, VISIT, std::is_base_of<batches_children, Problem>());
+		}
+
+		template <class Problem, class Node, class Actions, class Admit, class Visit>
+		inline void for_each_child(Problem const &PROBLEM, Node const &S, Actions const &ACTIONS, Admit const &ADMIT, Visit const &VISIT, std::false_type)
+		{
+			typedef typename Problem::Action Action;
+
+			std::for_each(std::begin(ACTIONS), std::end(ACTIONS), [&](Action const &ACTION)
+			{
+				auto const &SUCCESSOR(PROBLEM.result(S->state(), ACTION));
+				if(ADMIT(ACTION, SUCCESSOR))
+					VISIT(PROBLEM.child(S, ACTION, SUCCESSOR));
+			});
+		}
+
+		template <class Problem, class Node, class Actions, class Admit, class Visit>
+		inline void for_each_child(Problem const &PROBLEM, Node const &S, Actions const &ACTIONS, Admit const &ADMIT, Visit const &VISIT, std::true_type)
+		{
+			typedef typename Problem::Action Action;
+			typedef typename Problem::State State;
+
+			std::vector<std::pair<Action, State>> steps;
+			std::for_each(std::begin(ACTIONS), std::end(ACTIONS), [&](Action const &ACTION)
+			{
+				auto SUCCESSOR(PROBLEM.result(S->state(), ACTION));
+				if(ADMIT(ACTION, SUCCESSOR))
+					steps.emplace_back(ACTION, std::move(SUCCESSOR));
+			});
+
+			if(!steps.empty())
+				for(auto const &CHILD : PROBLEM.children(S, steps))
+					VISIT(CHILD);
+		}
+
+
+		/**
+		 * @brief Write the states on the path from the root to NODE to the output, goal first.
+		 */
+		template <typename Output, typename Node>
+		inline Output unravel(Output path, Node const &NODE)
+		{
+			for(auto node(NODE); node; node = node->parent())
+				*path++ = node->state();
+			return path;
+		}
+
+
+		/**
+		 * @brief The frontiers of multi_queue_search, visited by run-time index.
+		 *
+		 * Frontiers is a std::tuple of queue_sets that differ only in their comparator,
+		 * so the operations recurse over the tuple until they reach queue I.
+		 */
+		template <std::size_t I, std::size_t N>
+		struct queues
+		{
+			template <class Frontiers>
+			static bool empty(Frontiers const &FRONTIERS, std::size_t const i)
+			{
+				return i == I ? std::get<I>(FRONTIERS).empty() : queues<I + 1, N>::empty(FRONTIERS, i);
+			}
+
+			template <class Frontiers>
+			static typename std::tuple_element<0, Frontiers>::type::value_type pop(Frontiers &frontiers, std::size_t const i)
+			{
+				return i == I ? detail::pop(std::get<I>(frontiers)) : queues<I + 1, N>::pop(frontiers, i);
+			}
+
+			/**
+			 * Give CHILD to every frontier.  Where CHILD beats the best node that
+			 * frontier has ever seen, by the frontier's own comparator, call PROGRESS(I).
+			 */
+			template <class Frontiers, class Comparators, class Node, class Progress>
+			static void push(Frontiers &frontiers, Comparators const &COMPARATORS, std::array<Node, N> &best, Node const &CHILD, Progress const &PROGRESS)
+			{
+				detail::handle_child(std::get<I>(frontiers), CHILD, trace_evaluation<typename std::tuple_element<I, Comparators>::type>());
+				if(std::get<I>(COMPARATORS)(best[I], CHILD))
+				{
+					best[I] = CHILD;
+					PROGRESS(I);
+				}
+				queues<I + 1, N>::push(frontiers, COMPARATORS, best, CHILD, PROGRESS);
+			}
+		};
+
+
+		template <std::size_t N>
+		struct queues<N, N>
+		{
+			template <class Frontiers>
+			static bool empty(Frontiers const &, std::size_t const) { return true; }
+
+			template <class Frontiers>
+			static typename std::tuple_element<0, Frontiers>::type::value_type pop(Frontiers &, std::size_t const)
+			{
+				throw std::out_of_range("No such frontier.");
+			}
+
+			template <class Frontiers, class Comparators, class Node, class Progress>
+			static void push(Frontiers &, Comparators const &, std::array<Node, N> &, Node const &, Progress const &) {}
+		};
 	}
 
 
@@ -136,10 +283,15 @@ namespace jsearch
     /**************************
 	 * 	 	 Graph search	  *
 	 **************************/
+	/**
+	 * The ClosedPolicy decides what happens to a cheaper path to an expanded state: see closed_list.hpp.
+	 * The default, NeverReopen, discards it, which is only correct with a consistent heuristic.
+	 */
 	template <template <typename T, typename Comparator> class PriorityQueue,
 			template <typename Traits> class Comparator,
 			template <typename T> class Set,
 			template <typename Key, typename Value> class Map,
+			template <typename Traits_, template <typename T> class Set_, template <typename Key, typename Value> class Map_> class ClosedPolicy = NeverReopen,
 			typename Traits,
 			template <typename Traits_> class StepCostPolicy,
 			template <typename Traits_> class ActionsPolicy,
@@ -147,9 +299,9 @@ namespace jsearch
 			template <typename Traits_> class GoalTestPolicy,
 			template <typename Traits_> class CreatePolicy = DefaultNodeCreator,
 			template <typename Traits_,
-				template <typename Traits__> class StepCostPolicy,
-				template <typename Traits__> class ResultPolicy,
-				template <typename Traits__> class CreatePolicy>
+				template <typename Traits__> class StepCostPolicy_,
+				template <typename Traits__> class ResultPolicy_,
+				template <typename Traits__> class CreatePolicy_>
 				class ChildPolicy = DefaultChildPolicy,
             typename Output>
 	typename Traits::pathcost best_first_search(Problem<Traits, StepCostPolicy, ActionsPolicy, ResultPolicy, GoalTestPolicy, CreatePolicy, ChildPolicy> const &PROBLEM, Output path)
@@ -160,9 +312,12 @@ namespace jsearch
 		// typedef typename Traits::pathcost PathCost;
 
         jsearch::queue_set<PriorityQueue<Node, Comparator<Traits>>, Map> frontier;
-        Set<State> closed;
+        ClosedPolicy<Traits, Set, Map> closed;
+        detail::trace_evaluation<Comparator<Traits>> const EVALUATION;
 
-        frontier.push(PROBLEM.create(PROBLEM.initial, Node(), Action(), 0));
+        auto const INITIAL(PROBLEM.create(PROBLEM.initial, Node(), Action(), 0));
+        frontier.push(INITIAL);
+        detail::trace(trace_event::START, INITIAL, EVALUATION);
 
 		while(!frontier.empty())
 		{
@@ -173,41 +328,290 @@ namespace jsearch
 #ifdef STATISTICS
 			++stats.popped;
 #endif
+            detail::trace(trace_event::EXPAND, S, EVALUATION);
+            detail::poll_cancellation();
             if(PROBLEM.goal_test(S->state()))
 			{
 #ifndef NDEBUG
 				std::cout << "frontier: " << frontier.size() << "\n";
 				std::cout << "closed: " << closed.size() << "\n";
 #endif
-                std::function<Output(Output &, Node const &)> unravel =  [&](Output &path, Node const &node)
-                                {
-                                    *path++ = node->state();
-                                    if(node->parent())
-                                        return unravel(path, node->parent());
-                                    else
-                                        return path;
-                                };
-                unravel(path, S);
+#ifdef STATISTICS
+				stats.reopened += closed.reopened();
+#endif
+                detail::unravel(path, S);
                 return S->path_cost();
 			}
 			else
 			{
-                closed.insert(S->state());
+                closed.close(S->state(), S->path_cost());
                 auto const &ACTIONS(PROBLEM.actions(S->state()));
                 // TODO: Change to auto parameter declaration once C++14 is implemented.
-                std::for_each(std::begin(ACTIONS), std::end(ACTIONS), [&](Action const &ACTION)
+                detail::for_each_child(PROBLEM, S, ACTIONS, [&](Action const &ACTION, State const &SUCCESSOR)
+                {
+                    if(closed.admit(SUCCESSOR, [&]{ return S->path_cost() + PROBLEM.step_cost(S->state(), ACTION); }))
+                        return true;
+                    detail::trace_closed(PROBLEM, S, ACTION, SUCCESSOR, EVALUATION);
+                    return false;
+                }, [&](Node const &CHILD)
                 {
-                    auto const &SUCCESSOR(PROBLEM.result(S->state(), ACTION));
-                    if(closed.find(SUCCESSOR) == std::end(closed))
-                        detail::handle_child(frontier, PROBLEM.child(S, ACTION, SUCCESSOR));
+                    detail::handle_child(frontier, CHILD, EVALUATION);
                 });
 			}
 		}
 
+#ifdef STATISTICS
+		stats.reopened += closed.reopened();
+#endif
+		throw goal_not_found();
+	}
+
+
+	/**************************
+	 *	Multi-queue search	  *
+	 **************************/
+	/**
+	 * @brief Graph search with one frontier per comparator, taking turns between them.
+	 *
+	 * Every generated node goes on every frontier, but the nodes and the closed set are
+	 * shared, so a state expanded on behalf of one comparator is not expanded again on
+	 * behalf of another.  Typically each comparator is a Greedy cost function over a
+	 * different heuristic: it finds satisficing solutions, not optimal ones.
+	 *
+	 * Frontiers are chosen by priority, lowest first.  Each expansion from a frontier
+	 * costs it one, and a frontier that makes progress (receives a node better than any
+	 * it has seen before) is boosted by BOOST, so an informative heuristic keeps the
+	 * search for a while and an uninformative one does not stall it.  With BOOST == 0
+	 * this is plain round-robin alternation.  In a trace, each frontier reports its
+	 * own GENERATE, DUPLICATE and DECREASE events for every child, with f and h by
+	 * its own comparator; the other events have them by the first comparator.
+	 *
+	 * \return The path cost of the goal, whose path is written to PATH goal first.
+	 *
+	 * \throws goal_not_found
+	 */
+	template <template <typename T, typename Comparator> class PriorityQueue,
+			template <typename T> class Set,
+			template <typename Key, typename Value> class Map,
+			template <typename Traits_> class... Comparators,
+			typename Traits,
+			template <typename Traits_> class StepCostPolicy,
+			template <typename Traits_> class ActionsPolicy,
+			template <typename Traits_> class ResultPolicy,
+			template <typename Traits_> class GoalTestPolicy,
+			template <typename Traits_> class CreatePolicy,
+			template <typename Traits_,
+				template <typename Traits__> class StepCostPolicy_,
+				template <typename Traits__> class ResultPolicy_,
+				template <typename Traits__> class CreatePolicy_>
+				class ChildPolicy,
+            typename Output>
+	typename Traits::pathcost multi_queue_search(Problem<Traits, StepCostPolicy, ActionsPolicy, ResultPolicy, GoalTestPolicy, CreatePolicy, ChildPolicy> const &PROBLEM, Output path, unsigned const BOOST = 1000)
+	{
+		typedef typename Traits::node Node;
+		typedef typename Traits::state State;
+		typedef typename Traits::action Action;
+
+		constexpr std::size_t N(sizeof...(Comparators));
+		static_assert(N > 0, "At least one comparator is required.");
+		typedef detail::queues<0, N> Queues;
+
+		std::tuple<jsearch::queue_set<PriorityQueue<Node, Comparators<Traits>>, Map>...> frontiers;
+		std::tuple<Comparators<Traits>...> const COMPARATORS;
+		std::array<long, N> priority;
+		std::array<Node, N> best;
+		Set<State> closed;
+		detail::trace_evaluation<typename std::tuple_element<0, std::tuple<Comparators<Traits>...>>::type> const EVALUATION;
+
+		auto const INITIAL(PROBLEM.create(PROBLEM.initial, Node(), Action(), 0));
+		priority.fill(0);
+		best.fill(INITIAL);
+		detail::trace(trace_event::START, INITIAL, EVALUATION);
+		Queues::push(frontiers, COMPARATORS, best, INITIAL, [](std::size_t){});
+
+		auto const PROGRESS([&](std::size_t const I) { priority[I] -= BOOST; });
+
+		for(;;)
+		{
+			// Pick the non-empty frontier with the lowest priority.
+			std::size_t chosen(N);
+			for(std::size_t i(0); i != N; ++i)
+				if(!Queues::empty(frontiers, i) && (chosen == N || priority[i] < priority[chosen]))
+					chosen = i;
+
+			if(chosen == N)
+				break;
+
+			auto const S(Queues::pop(frontiers, chosen));
+
+			// Already expanded on behalf of another frontier.
+			if(closed.find(S->state()) != std::end(closed))
+				continue;
+
+			++priority[chosen];
+#ifdef STATISTICS
+			++stats.popped;
+#endif
+			detail::trace(trace_event::EXPAND, S, EVALUATION);
+			detail::poll_cancellation();
+			if(PROBLEM.goal_test(S->state()))
+			{
+				detail::unravel(path, S);
+				return S->path_cost();
+			}
+
+			closed.insert(S->state());
+			auto const &ACTIONS(PROBLEM.actions(S->state()));
+			detail::for_each_child(PROBLEM, S, ACTIONS, [&](Action const &ACTION, State const &SUCCESSOR)
+			{
+				if(closed.find(SUCCESSOR) == std::end(closed))
+					return true;
+				detail::trace_closed(PROBLEM, S, ACTION, SUCCESSOR, EVALUATION);
+				return false;
+			}, [&](Node const &CHILD)
+			{
+				Queues::push(frontiers, COMPARATORS, best, CHILD, PROGRESS);
+			});
+		}
+
 		throw goal_not_found();
 	}
 
 
+	/**************************
+	 *	 Shortest-path tree	  *
+	 **************************/
+	namespace detail
+	{
+		/**
+		 * Dijkstra's algorithm from the initial state, settling states into SETTLED
+		 * until DONE(state) is true of the state just settled or none are left.
+		 */
+		template <template <typename T, typename Comparator> class PriorityQueue,
+				template <typename Key, typename Value> class Map,
+				typename Traits,
+				template <typename Traits_> class StepCostPolicy,
+				template <typename Traits_> class ActionsPolicy,
+				template <typename Traits_> class ResultPolicy,
+				template <typename Traits_> class GoalTestPolicy,
+				template <typename Traits_> class CreatePolicy,
+				template <typename Traits_,
+					template <typename Traits__> class StepCostPolicy_,
+					template <typename Traits__> class ResultPolicy_,
+					template <typename Traits__> class CreatePolicy_>
+					class ChildPolicy,
+				typename Done>
+		void settle(Problem<Traits, StepCostPolicy, ActionsPolicy, ResultPolicy, GoalTestPolicy, CreatePolicy, ChildPolicy> const &PROBLEM, Map<typename Traits::state, typename Traits::node> &settled, Done const &DONE)
+		{
+			typedef typename Traits::node Node;
+			typedef typename Traits::action Action;
+
+			jsearch::queue_set<PriorityQueue<Node, SimpleComparator<Traits, Dijkstra>>, Map> frontier;
+			detail::trace_evaluation<SimpleComparator<Traits, Dijkstra>> const EVALUATION;
+			auto const INITIAL(PROBLEM.create(PROBLEM.initial, Node(), Action(), 0));
+			frontier.push(INITIAL);
+			detail::trace(trace_event::START, INITIAL, EVALUATION);
+
+			while(!frontier.empty())
+			{
+				auto const S(detail::pop(frontier));
+#ifdef STATISTICS
+				++stats.popped;
+#endif
+				detail::trace(trace_event::EXPAND, S, EVALUATION);
+				detail::poll_cancellation();
+				settled.insert(std::make_pair(S->state(), S));
+				if(DONE(S->state()))
+					return;
+
+				auto const &ACTIONS(PROBLEM.actions(S->state()));
+				detail::for_each_child(PROBLEM, S, ACTIONS, [&](Action const &ACTION, typename Traits::state const &SUCCESSOR)
+				{
+					if(settled.find(SUCCESSOR) == std::end(settled))
+						return true;
+					detail::trace_closed(PROBLEM, S, ACTION, SUCCESSOR, EVALUATION);
+					return false;
+				}, [&](Node const &CHILD)
+				{
+					detail::handle_child(frontier, CHILD, EVALUATION);
+				});
+			}
+		}
+	}
+
+
+	/**
+	 * @brief The shortest paths from the initial state to every state it reaches, by Dijkstra's algorithm.
+	 *
+	 * One search does the work of a point-to-point search to each state: afterwards SETTLED
+	 * maps each reachable state to its node, whose path_cost() is the state's distance and
+	 * whose parent() is its predecessor on a shortest path.  The goal test is not used.
+	 * Step costs must not be negative.  With dense_map for Map and integer states the
+	 * result is a flat array indexed by state.
+	 */
+	template <template <typename T, typename Comparator> class PriorityQueue,
+			template <typename Key, typename Value> class Map,
+			typename Traits,
+			template <typename Traits_> class StepCostPolicy,
+			template <typename Traits_> class ActionsPolicy,
+			template <typename Traits_> class ResultPolicy,
+			template <typename Traits_> class GoalTestPolicy,
+			template <typename Traits_> class CreatePolicy = DefaultNodeCreator,
+			template <typename Traits_,
+				template <typename Traits__> class StepCostPolicy_,
+				template <typename Traits__> class ResultPolicy_,
+				template <typename Traits__> class CreatePolicy_>
+				class ChildPolicy = DefaultChildPolicy>
+	void shortest_path_tree(Problem<Traits, StepCostPolicy, ActionsPolicy, ResultPolicy, GoalTestPolicy, CreatePolicy, ChildPolicy> const &PROBLEM, Map<typename Traits::state, typename Traits::node> &settled)
+	{
+		detail::settle<PriorityQueue, Map>(PROBLEM, settled, [](typename Traits::state const &){ return false; });
+	}
+
+
+	/**
+	 * @brief As above, but stop as soon as every state in TARGETS is settled.
+	 *
+	 * States settled on the way are in SETTLED too.  A target that is not in SETTLED
+	 * afterwards cannot be reached, in which case the whole space was searched.
+	 */
+	template <template <typename T, typename Comparator> class PriorityQueue,
+			template <typename Key, typename Value> class Map,
+			typename Traits,
+			template <typename Traits_> class StepCostPolicy,
+			template <typename Traits_> class ActionsPolicy,
+			template <typename Traits_> class ResultPolicy,
+			template <typename Traits_> class GoalTestPolicy,
+			template <typename Traits_> class CreatePolicy = DefaultNodeCreator,
+			template <typename Traits_,
+				template <typename Traits__> class StepCostPolicy_,
+				template <typename Traits__> class ResultPolicy_,
+				template <typename Traits__> class CreatePolicy_>
+				class ChildPolicy = DefaultChildPolicy,
+			typename Targets>
+	void shortest_path_tree(Problem<Traits, StepCostPolicy, ActionsPolicy, ResultPolicy, GoalTestPolicy, CreatePolicy, ChildPolicy> const &PROBLEM, Map<typename Traits::state, typename Traits::node> &settled, Targets const &TARGETS)
+	{
+		typedef typename Traits::state State;
+
+		Map<State, bool> pending; // Whether each target is still to be settled.
+		std::size_t remaining(0);
+		for(auto const &TARGET : TARGETS)
+			if(pending.insert(std::make_pair(TARGET, true)).second)
+				++remaining;
+
+		if(remaining)
+			detail::settle<PriorityQueue, Map>(PROBLEM, settled, [&](State const &STATE)
+			{
+				auto const IT(pending.find(STATE));
+				if(IT != std::end(pending) && IT->second)
+				{
+					IT->second = false;
+					--remaining;
+				}
+				return remaining == 0;
+			});
+	}
+
+
 	/**************************
 	 *		Tree search		  *
 	 **************************/
@@ -220,9 +624,9 @@ namespace jsearch
 			template <typename Traits_> class GoalTestPolicy,
 			template <typename Traits_> class CreatePolicy = DefaultNodeCreator,
 			template <typename Traits_,
-				template <typename Traits__> class StepCostPolicy,
-				template <typename Traits__> class ResultPolicy,
-				template <typename Traits__> class CreatePolicy>
+				template <typename Traits__> class StepCostPolicy_,
+				template <typename Traits__> class ResultPolicy_,
+				template <typename Traits__> class CreatePolicy_>
 				class ChildPolicy = DefaultChildPolicy>
 	typename Traits::node best_first_search(Problem<Traits, StepCostPolicy, ActionsPolicy, ResultPolicy, GoalTestPolicy, CreatePolicy, ChildPolicy> const &PROBLEM)
 	{
@@ -239,6 +643,7 @@ namespace jsearch
 		while(!frontier.empty())
 		{
             auto const S(detail::pop(frontier));
+			detail::poll_cancellation();
 
 			if(PROBLEM.goal_test(S->state()))
 			{
@@ -333,9 +738,9 @@ namespace jsearch
 			template <typename Traits_> class GoalTestPolicy,
 			template <typename Traits_> class CreatePolicy = DefaultNodeCreator,
 			template <typename Traits_,
-				template <typename Traits__> class StepCostPolicy,
-				template <typename Traits__> class ResultPolicy,
-				template <typename Traits__> class CreatePolicy>
+				template <typename Traits__> class StepCostPolicy_,
+				template <typename Traits__> class ResultPolicy_,
+				template <typename Traits__> class CreatePolicy_>
 				class ChildPolicy = DefaultChildPolicy>
 		SearchResult<Traits> recursive_best_first_search(Problem<Traits, StepCostPolicy, ActionsPolicy, ResultPolicy, GoalTestPolicy, CreatePolicy, ChildPolicy> const &PROBLEM, CostFunction<Traits> const &COST, typename Traits::node const &NODE, typename Traits::pathcost const &F_N, typename Traits::pathcost const &B)
 		{
@@ -361,6 +766,7 @@ namespace jsearch
 #ifndef RBFS_INF
 #define RBFS_INF	std::numeric_limits<PathCost>::max()
 #endif
+			detail::poll_cancellation();
 			auto const f_N(COST.f(NODE));
 
 			// IF f(N)>B, return f(N)
@@ -379,16 +785,18 @@ namespace jsearch
 			PriorityQueue<RBFSNodeCost> children;
 
 			// FOR each child Ni of N,
-			for(auto const ACTION : ACTIONS)
+			detail::for_each_child(PROBLEM, NODE, ACTIONS, [](typename Traits::action const &, typename Traits::state const &)
+			{
+				return true;
+			}, [&](typename Traits::node const &CHILD)
 			{
-				auto const CHILD(PROBLEM.child(NODE, ACTION));
 				auto const f_CHILD(COST.f(CHILD));
 				// IF f(N)<F(N) THEN F[i] := MAX(F(N),f(Ni))
 				// ELSE F[i] := f(Ni)
 				auto const f_RESULT(f_N < F_N ? std::max(F_N, f_CHILD) : f_CHILD);
 				auto const HANDLE(children.push(RBFSNodeCost(CHILD, f_RESULT)));
 				(*HANDLE).handle = HANDLE; // Looks weird, makes sense.
-			}
+			});
 
 			// sort Ni and F[i] in increasing order of F[i]
 			/*	They sort automatically.	*/
@@ -441,9 +849,9 @@ namespace jsearch
 		template <typename Traits_> class GoalTestPolicy,
 		template <typename Traits_> class CreatePolicy = DefaultNodeCreator,
 		template <typename Traits_,
-			template <typename Traits__> class StepCostPolicy,
-			template <typename Traits__> class ResultPolicy,
-			template <typename Traits__> class CreatePolicy>
+			template <typename Traits__> class StepCostPolicy_,
+			template <typename Traits__> class ResultPolicy_,
+			template <typename Traits__> class CreatePolicy_>
 			class ChildPolicy = DefaultChildPolicy>
 	typename Traits::node recursive_best_first_search(Problem<Traits, StepCostPolicy, ActionsPolicy, ResultPolicy, GoalTestPolicy, CreatePolicy, ChildPolicy> const &PROBLEM)
 	{
@@ -464,6 +872,102 @@ namespace jsearch
 		
 		return RESULT.first;
 	}
+
+
+	/*******************************
+	* Iterative-deepening search   *
+	*******************************/
+	namespace recursive
+	{
+		/**
+		 * One depth-first search of the nodes with f no greater than BOUND, not to be called by clients.
+		 *
+		 * \return The goal node, or nullptr and the least f that exceeded BOUND.
+		 */
+		template <template <typename Traits> class CostFunction,
+			typename Traits,
+			template <typename Traits_> class StepCostPolicy,
+			template <typename Traits_> class ActionsPolicy,
+			template <typename Traits_> class ResultPolicy,
+			template <typename Traits_> class GoalTestPolicy,
+			template <typename Traits_> class CreatePolicy,
+			template <typename Traits_,
+				template <typename Traits__> class StepCostPolicy_,
+				template <typename Traits__> class ResultPolicy_,
+				template <typename Traits__> class CreatePolicy_>
+				class ChildPolicy>
+		SearchResult<Traits> depth_first_contour(Problem<Traits, StepCostPolicy, ActionsPolicy, ResultPolicy, GoalTestPolicy, CreatePolicy, ChildPolicy> const &PROBLEM, CostFunction<Traits> const &COST, typename Traits::node const &NODE, typename Traits::pathcost const &BOUND)
+		{
+			typedef typename Traits::pathcost PathCost;
+
+			detail::poll_cancellation();
+			auto const f_N(COST.f(NODE));
+			if(f_N > BOUND)
+				return SearchResult<Traits>(nullptr, f_N);
+
+			if(PROBLEM.goal_test(NODE->state()))
+				return SearchResult<Traits>(NODE, f_N);
+
+			PathCost next(std::numeric_limits<PathCost>::max());
+			auto const ACTIONS(PROBLEM.actions(NODE->state()));
+			for(auto const &ACTION : ACTIONS)
+			{
+				auto const RESULT(depth_first_contour<CostFunction>(PROBLEM, COST, PROBLEM.child(NODE, ACTION), BOUND));
+				if(RESULT.first)
+					return RESULT;
+				next = std::min(next, RESULT.second);
+			}
+
+			return SearchResult<Traits>(nullptr, next);
+		}
+	}
+
+
+	/**
+	 * \brief Iterative-deepening search from Korf (1985); with the AStar cost function it is IDA*.
+	 *
+	 * A series of depth-first searches, each of the nodes whose f is no greater than
+	 * a bound, starting at f of the initial node and raised each time to the least f
+	 * that exceeded it.  Memory is linear in the depth of the solution, but nothing
+	 * is remembered between branches or iterations, so duplicate states are only
+	 * avoided as far as the ActionsPolicy prunes them (typically by not undoing the
+	 * move that made the state).  With an admissible heuristic the goal is optimal.
+	 *
+	 * \return A goal Node from which the path can be reconstructed.
+	 *
+	 * \throws goal_not_found
+	 */
+	template <template <typename Traits> class CostFunction,
+		typename Traits,
+		template <typename Traits_> class StepCostPolicy,
+		template <typename Traits_> class ActionsPolicy,
+		template <typename Traits_> class ResultPolicy,
+		template <typename Traits_> class GoalTestPolicy,
+		template <typename Traits_> class CreatePolicy = DefaultNodeCreator,
+		template <typename Traits_,
+			template <typename Traits__> class StepCostPolicy_,
+			template <typename Traits__> class ResultPolicy_,
+			template <typename Traits__> class CreatePolicy_>
+			class ChildPolicy = DefaultChildPolicy>
+	typename Traits::node iterative_deepening_search(Problem<Traits, StepCostPolicy, ActionsPolicy, ResultPolicy, GoalTestPolicy, CreatePolicy, ChildPolicy> const &PROBLEM)
+	{
+		typedef typename Traits::node Node;
+		typedef typename Traits::action Action;
+		typedef typename Traits::pathcost PathCost;
+
+		auto const INITIAL(PROBLEM.create(PROBLEM.initial, Node(), Action(), 0));
+		CostFunction<Traits> const COST;
+
+		for(auto bound(COST.f(INITIAL)); bound != std::numeric_limits<PathCost>::max(); )
+		{
+			auto const RESULT(recursive::depth_first_contour<CostFunction>(PROBLEM, COST, INITIAL, bound));
+			if(RESULT.first)
+				return RESULT.first;
+			bound = RESULT.second;
+		}
+
+		throw goal_not_found();
+	}
 }
 
 #endif // SEARCH_H
@@ -26,6 +26,7 @@
 #define EVALUATION_H
 
 #include <functional>
+#include <type_traits>
 
 #ifndef NDEBUG
 #include <iostream>
@@ -33,6 +34,38 @@
 
 namespace jsearch
 {
+	namespace detail
+	{
+		template <typename Element, typename Heuristic, typename = void>
+		struct carries_h : std::false_type {};
+
+		template <typename Element, typename Heuristic>
+		struct carries_h<Element, Heuristic, typename std::enable_if<std::is_same<typename Element::heuristic, Heuristic>::value>::type> : std::true_type {};
+
+		template <typename Node, typename Evaluate>
+		auto node_h(Node const &NODE, Evaluate const &EVALUATE, std::true_type) -> decltype(EVALUATE(NODE->state()))
+		{
+			return NODE->has_h() ? NODE->h() : EVALUATE(NODE->state());
+		}
+
+		template <typename Node, typename Evaluate>
+		auto node_h(Node const &NODE, Evaluate const &EVALUATE, std::false_type) -> decltype(EVALUATE(NODE->state()))
+		{
+			return EVALUATE(NODE->state());
+		}
+
+		/**
+		 * The value of Heuristic for NODE: the one NODE carries if it carries Heuristic's
+		 * (see HeuristicNode), otherwise EVALUATE(NODE->state()).
+		 */
+		template <typename Heuristic, typename Node, typename Evaluate>
+		auto node_h(Node const &NODE, Evaluate const &EVALUATE) -> decltype(EVALUATE(NODE->state()))
+		{
+			return node_h(NODE, EVALUATE, carries_h<typename Node::element_type, Heuristic>());
+		}
+	}
+
+
 	template <typename Traits>
 	class ZeroHeuristic
 	{
@@ -69,7 +102,7 @@ namespace jsearch
 
 	// Low-h tie policy, non-total.
 	template <typename Traits, template <typename Traits_> class HeuristicPolicy>
-	class LowH : protected virtual HeuristicPolicy<Traits>
+	class LowH : protected HeuristicPolicy<Traits>
 	{
 		using HeuristicPolicy<Traits>::h;
 		
@@ -84,7 +117,8 @@ namespace jsearch
 		// This function would ideally be called "break" but obviously that is taken.
 		bool split(Node const &A, Node const &B) const
 		{
-            auto const Ah(h(A->state())), Bh(h(B->state()));
+			auto const EVALUATE([this](State const &S){ return h(S); });
+			auto const Ah(detail::node_h<HeuristicPolicy<Traits>>(A, EVALUATE)), Bh(detail::node_h<HeuristicPolicy<Traits>>(B, EVALUATE));
 			return Ah > Bh;
 		}
 	};
@@ -92,7 +126,7 @@ namespace jsearch
 
 	// Low-h tie policy, total ordering.
 	template <typename Traits, template <typename Traits_> class HeuristicPolicy>
-	class LowHTotal : protected virtual HeuristicPolicy<Traits>
+	class LowHTotal : protected HeuristicPolicy<Traits>
 	{
 		using HeuristicPolicy<Traits>::h;
 		
@@ -107,7 +141,8 @@ namespace jsearch
 		// This function would ideally be called "break" but obviously that is taken.
 		bool split(Node const &A, Node const &B) const
 		{
-            auto const Ah(h(A->state())), Bh(h(B->state()));
+			auto const EVALUATE([this](State const &S){ return h(S); });
+			auto const Ah(detail::node_h<HeuristicPolicy<Traits>>(A, EVALUATE)), Bh(detail::node_h<HeuristicPolicy<Traits>>(B, EVALUATE));
             auto const RESULT(Ah == Bh ? A->state() > B->state() : Ah > Bh);
 			return RESULT;
 		}
@@ -139,8 +174,8 @@ namespace jsearch
 			template <typename Traits_> class HeuristicPolicy = ZeroHeuristic,
 			template <typename Traits_> class PathCostPolicy = DefaultPathCost>
 	class AStar :
-			protected virtual HeuristicPolicy<Traits>,
-			protected virtual PathCostPolicy<Traits>
+			protected HeuristicPolicy<Traits>,
+			protected PathCostPolicy<Traits>
 	{
 		using PathCostPolicy<Traits>::g;
 		using HeuristicPolicy<Traits>::h;
@@ -154,7 +189,7 @@ namespace jsearch
 
 		Cost f(Node const &N) const
 		{
-            return g(N) + h(N->state());
+			return g(N) + detail::node_h<HeuristicPolicy<Traits>>(N, [this](typename Traits::state const &S){ return h(S); });
 		}
 	};
 
@@ -162,7 +197,7 @@ namespace jsearch
 	/**	Greedy: f(n) = h(n)
 	 */
 	template <typename Traits, template <typename Traits_> class HeuristicPolicy = ZeroHeuristic>
-	class Greedy : protected virtual HeuristicPolicy<Traits>
+	class Greedy : protected HeuristicPolicy<Traits>
 	{
 		using HeuristicPolicy<Traits>::h;
 
@@ -176,7 +211,7 @@ namespace jsearch
 		Cost f(Node const &N) const
 		{
 			// TODO: Need a conversion function from HeuristicCost to Cost?
-            return h(N->state());
+			return detail::node_h<HeuristicPolicy<Traits>>(N, [this](typename Traits::state const &S){ return h(S); });
 		}
 	};
 
@@ -184,7 +219,7 @@ namespace jsearch
 	/**	Dijkstra: f(n) = g(n)
 	 */
 	template <typename Traits, template <typename Traits_> class PathCostPolicy = DefaultPathCost>
-	class Dijkstra : protected virtual PathCostPolicy<Traits>
+	class Dijkstra : protected PathCostPolicy<Traits>
 	{
 		using PathCostPolicy<Traits>::g;
 
@@ -204,6 +239,46 @@ namespace jsearch
 	};
 
 
+	namespace detail
+	{
+		/** The value of HeuristicPolicy for a node, the carried one if it has it. */
+		template <typename Traits, template <typename Traits_> class HeuristicPolicy>
+		class heuristic_value : protected HeuristicPolicy<Traits>
+		{
+		public:
+			heuristic_value() {}
+
+			typename Traits::pathcost operator()(typename Traits::node const &NODE) const
+			{
+				return node_h<HeuristicPolicy<Traits>>(NODE, [this](typename Traits::state const &S){ return this->h(S); });
+			}
+		};
+
+
+		/** The heuristic of a CostPolicy as a heuristic_value, as type.  Not defined for other cost functions. */
+		template <typename CostFunction>
+		struct cost_heuristic {};
+
+		template <typename Traits, template <typename Traits_> class HeuristicPolicy, template <typename Traits_> class PathCostPolicy>
+		struct cost_heuristic<AStar<Traits, HeuristicPolicy, PathCostPolicy>>
+		{
+			typedef heuristic_value<Traits, HeuristicPolicy> type;
+		};
+
+		template <typename Traits, template <typename Traits_> class HeuristicPolicy>
+		struct cost_heuristic<Greedy<Traits, HeuristicPolicy>>
+		{
+			typedef heuristic_value<Traits, HeuristicPolicy> type;
+		};
+
+		template <typename Traits, template <typename Traits_> class PathCostPolicy>
+		struct cost_heuristic<Dijkstra<Traits, PathCostPolicy>>
+		{
+			typedef heuristic_value<Traits, ZeroHeuristic> type;
+		};
+	}
+
+
 	/**********************
 	 * Comparator classes *
 	 **********************/
@@ -212,18 +287,22 @@ namespace jsearch
 	 * CostPolicy and TiePolicy are not required to have any relationship.  That is, although a typical
 	 * TiePolicy might split ties on the same heuristic that the CostPolicy uses, it is just as possible
 	 * that the TiePolicy splits on something totally unrelated.
+	 *
+	 * The policies are ordinary bases, so a heuristic that both use is inherited twice, but as
+	 * they are stateless the comparator is still an empty class and costs the heap nothing to copy.
 	 */
 	template <typename Traits,
 				template <typename Traits_> class CostPolicy = AStar,
 				template <typename Traits_> class TiePolicy = LowH>
-	class TiebreakingComparator : protected virtual CostPolicy<Traits>,
-									protected virtual TiePolicy<Traits>
+	class TiebreakingComparator : protected CostPolicy<Traits>,
+									protected TiePolicy<Traits>
 	{
 		using TiePolicy<Traits>::split;
 		using CostPolicy<Traits>::f;
 
 	public:
 		typedef typename Traits::node Node;
+		typedef CostPolicy<Traits> cost_function;
 
 		TiebreakingComparator() {}
 
@@ -239,12 +318,13 @@ namespace jsearch
 	/** SimpleComparator does not break ties, it just compares f(), and so uses the Dijkstra CostPolicy by default.
 	 */
 	template <typename Traits, template <typename Traits_> class CostPolicy = Dijkstra>
-	class SimpleComparator : protected virtual CostPolicy<Traits>
+	class SimpleComparator : protected CostPolicy<Traits>
 	{
 		using CostPolicy<Traits>::f;
 
 	public:
 		typedef typename Traits::node Node;
+		typedef CostPolicy<Traits> cost_function;
 
 		SimpleComparator() {}
 
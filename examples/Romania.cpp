@@ -24,6 +24,8 @@
 #include <boost/heap/d_ary_heap.hpp>
 #include <unordered_set>
 #include <functional>
+#include <vector>
+#include <iterator>
 
 using namespace jsearch;
 using namespace std;
@@ -74,4 +76,14 @@ int main(int, char **)
 	{
 		cout << "No path from " << INITIAL << " to the goal could be found!\n";
 	}
+
+	// One search for the distance from Arad to every city.
+	Map<State, Node> tree;
+	jsearch::shortest_path_tree<PriorityQueue, Map>(BUCHAREST, tree);
+	vector<Node> cities;
+	transform(begin(tree), end(tree), back_inserter(cities), [](Map<State, Node>::value_type const &CITY){ return CITY.second; });
+	sort(begin(cities), end(cities), [](Node const &A, Node const &B){ return A->path_cost() < B->path_cost(); });
+	cout << "\nFrom " << INITIAL << ":\n";
+	for(auto const &CITY : cities)
+		cout << CITY->state() << ": " << CITY->path_cost() << (CITY->parent() ? " via " + CITY->parent()->state() : "") << "\n";
 }
@@ -31,6 +31,7 @@
 #include <string>
 #include <algorithm>
 #include <vector>
+#include <functional>
 
 #define BOOST_RESULT_OF_USE_DECLTYPE
 
@@ -19,6 +19,10 @@
 #include "TSP.hpp"
 #include "problem.hpp"
 #include "bestfirstsearch.hpp"
+#include "tsplib.hpp"
+#include "registry.hpp"
+#include "portfolio.hpp"
+#include "parallel_children.hpp"
 
 #include <iostream>
 #include <algorithm>
@@ -26,16 +30,13 @@
 #include <chrono>
 #include <locale>
 #include <queue>
+#include <random>
+#include <functional>
+#include <thread>
 
-// UNCOMMENT THESE IF YOU HAVE BOOST >= 1.49.0
-/*
-#include <boost/heap/pairing_heap.hpp>
-#include <boost/heap/binomial_heap.hpp>
-#include <boost/heap/d_ary_heap.hpp>
-#include <boost/heap/priority_queue.hpp>
-#include <boost/heap/fibonacci_heap.hpp>
-*/
+// benchmarks/queues compares the other Boost.Heap queues as the frontier.
 #include <boost/heap/d_ary_heap.hpp>
+#include <boost/heap/pairing_heap.hpp>
 
 #ifndef NDEBUG
 #include <boost/graph/graphviz.hpp>
@@ -50,22 +51,12 @@ Graph Australia();
 Graph procedural(size_t const &n, mt19937::result_type const &SEED);
 
 
-struct EdgeDescComp
-{
-public:
-	bool operator()(edge_desc const &A, edge_desc const &B) const
-	{
-		return (*problem)[A] < (*problem)[B];
-	}
-};
-
-
 // Create template aliases that specify node evaluation.
 template <typename Traits>
-using CostFunction = AStar<Traits, MinimalImaginableTour>;
+using CostFunction = AStar<Traits, OneTreeBound>;
 
 template <typename Traits>
-using TieBreaking = LowH<Traits, MinimalImaginableTour>;
+using TieBreaking = LowH<Traits, OneTreeBound>;
 
 template <typename T, typename Comp>
 using PriorityQueue = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>, boost::heap::arity<2>, boost::heap::compare<Comp>>;
@@ -73,14 +64,119 @@ using PriorityQueue = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>, bo
 template <typename Traits>
 using Comparator = TiebreakingComparator<Traits, CostFunction, TieBreaking>;
 
+template <typename Traits, template <typename> class StepCost, template <typename> class Result, template <typename> class Create>
+using BoundedChild = IncrementalChildPolicy<Traits, OneTreeBound, StepCost, Result, Create>;
+
+// Bounding the children is most of the work of an expansion, so it is shared out between threads (see -j).
+template <typename Traits, template <typename> class StepCost, template <typename> class Result, template <typename> class Create>
+using ParallelBoundedChild = ParallelChildPolicy<Traits, BoundedChild, StepCost, Result, Create>;
+
+typedef Problem<TSP, EdgeCost, HigherCostValidEdges, AppendEdge, ValidTour, ComboNodeCreator, ParallelBoundedChild> TSPProblem;
+
+
+// The alternatives to the default search, chosen with -s.  Several, separated by commas, race as a portfolio.
+template <typename T, typename Comp>
+using PriorityQueue4 = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>, boost::heap::arity<4>, boost::heap::compare<Comp>>;
+
+template <typename T, typename Comp>
+using PairingQueue = boost::heap::pairing_heap<T, boost::heap::compare<Comp>>;
+
+template <typename T>
+using RBFSPriorityQueue = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>, boost::heap::arity<2>>;
+
+template <typename Traits>
+using TotalTieBreaking = LowHTotal<Traits, OneTreeBound>;
+
+template <typename Traits>
+using TotalComparator = TiebreakingComparator<Traits, CostFunction, TotalTieBreaking>;
+
+template <typename Traits>
+using GreedyCost = Greedy<Traits, OneTreeBound>;
+
+template <typename Traits>
+using GreedyComparator = TiebreakingComparator<Traits, GreedyCost, TieBreaking>;
+
+
+search_registry<TSP::node(TSPProblem const &)> searches()
+{
+	search_registry<TSP::node(TSPProblem const &)> result;
+	result.add("astar", [](TSPProblem const &P) { return best_first_search<PriorityQueue, Comparator>(P); })
+		.add("astar-d4", [](TSPProblem const &P) { return best_first_search<PriorityQueue4, Comparator>(P); })
+		.add("astar-pairing", [](TSPProblem const &P) { return best_first_search<PairingQueue, Comparator>(P); })
+		.add("astar-lowhtotal", [](TSPProblem const &P) { return best_first_search<PriorityQueue, TotalComparator>(P); })
+		.add("greedy", [](TSPProblem const &P) { return best_first_search<PriorityQueue, GreedyComparator>(P); })
+		.add("rbfs", [](TSPProblem const &P) { return recursive_best_first_search<CostFunction, FalseTiePolicy, RBFSPriorityQueue>(P); })
+		.add("ida", [](TSPProblem const &P) { return iterative_deepening_search<CostFunction>(P); });
+	return result;
+}
+
 
 int main(int argc, char **argv)
 {
+	size_t n(0);
 	float weight = 10.0;
 	mt19937::result_type seed(chrono::high_resolution_clock::to_time_t(chrono::high_resolution_clock::now()));
+	unique_ptr<tsp_instance> instance;
+	string output, search("astar");
+	unsigned threads(max(1u, thread::hardware_concurrency()));
+	auto const SEARCHES(searches());
 	
 	// TODO: Use Program Options from Boost?
-	switch(argc)
+	for(;;)
+	{
+		if(argc > 2 && string(argv[1]) == "-o")
+			output = argv[2];
+		else if(argc > 2 && string(argv[1]) == "-s")
+			search = argv[2];
+		else if(argc > 2 && string(argv[1]) == "-j")
+			istringstream(argv[2]) >> threads;
+		else
+			break;
+		argv[2] = argv[0];
+		argv += 2;
+		argc -= 2;
+	}
+
+	vector<string> names;
+	istringstream list(search);
+	for(string name; getline(list, name, ','); )
+		names.push_back(name);
+	for(auto const &NAME : names)
+	{
+		if(!SEARCHES.find(NAME))
+		{
+			cerr << "Unknown search: " << NAME << ".  Searches:";
+			for(auto const &KNOWN : SEARCHES.names())
+				cerr << " " << KNOWN;
+			cerr << "\n";
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if(argc == 3 && string(argv[1]) == "-f")
+	{
+		auto const T0(chrono::steady_clock::now());
+		try
+		{
+			if(instance_file::is_instance_file(argv[2]))
+				instance = instance_file::read_tsp(argv[2]);
+			else
+			{
+				auto problem(tsplib::load(argv[2]));
+				cout << "instance: " << problem.name << "\n";
+				instance.reset(new tsp_instance(problem.dimension, move(problem.cost)));
+			}
+		}
+		catch(runtime_error const &EX)
+		{
+			cerr << EX.what() << "\n";
+			exit(EXIT_FAILURE);
+		}
+		auto const ELAPSED(chrono::steady_clock::now() - T0);
+		cout << "n: " << instance->n << "\n";
+		cout << "Loaded in " << chrono::duration_cast<chrono::milliseconds>(ELAPSED).count() << " ms\n";
+	}
+	else switch(argc)
 	{
 		case 4:
 			// TODO: Make weight a run-time value.
@@ -95,7 +191,7 @@ int main(int argc, char **argv)
 
 		case 1:
 		case 0:
-			cerr << "Missing required value for n as argument 1.\n";
+			cerr << "Invocation: TSP [-o <instance file>] [-s <search>[,<search>...]] [-j <threads>] <n> [seed] [weight]\n            TSP [-o <instance file>] [-s <search>[,<search>...]] [-j <threads>] -f <TSPLIB or instance file>\n";
 			exit(EXIT_FAILURE);
 			break;
 
@@ -105,26 +201,59 @@ int main(int argc, char **argv)
 			break;
 	}
 
-	cout << "PriorityQueue: " << typeid(PriorityQueue<char, CostFunction<TSP>>).name() << "\n";
-	problem.reset(new Graph(procedural(n, seed)));
-	N = problem->m_num_edges;
-	EDGES.reserve(N);
-	pair<edge_iter, edge_iter> const EP(boost::edges(*problem));
-	transform(EP.first, EP.second, back_inserter(EDGES), [&](edge_desc const &E){ return E; });
-	sort(begin(EDGES), end(EDGES), EdgeDescComp());
+	if(!instance)
+		instance.reset(new tsp_instance(procedural(n, seed)));
+
+	if(!output.empty())
+	{
+		try
+		{
+			instance_file::write(output, *instance);
+		}
+		catch(runtime_error const &EX)
+		{
+			cerr << EX.what() << "\n";
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	cout << "search: " << search << "\n";
+	tsp_instance const &INSTANCE(*instance);
+	context<tsp_instance> const CONTEXT(INSTANCE);
 
 #ifndef NDEBUG
-	cout << "Sorted edge descriptors: " << jwm::to_string(EDGES) << endl;
+	cout << "Sorted edge descriptors: " << jwm::to_string(vector<tsp_edge>(begin(INSTANCE.edges), end(INSTANCE.edges))) << endl;
 #endif
 	
 	TSP::state const INITIAL;
-	Problem<TSP, EdgeCost, HigherCostValidEdges, AppendEdge, ValidTour, ComboNodeCreator> const MINIMAL(INITIAL);
+	TSPProblem const MINIMAL(INITIAL);
 	cout.imbue(locale(""));
 	
 	try
 	{
-		// Change this to WAStarTSP to use weighted A* (and adjust the weight above if desired).
-		auto const SOLUTION(jsearch::best_first_search<PriorityQueue, Comparator>(MINIMAL));
+		TSP::node SOLUTION;
+		if(names.size() == 1)
+		{
+			thread_pool pool(max(1u, threads));
+			child_threads const THREADS(pool);
+			context<child_threads> const CHILDREN(THREADS);
+			SOLUTION = SEARCHES(search, MINIMAL);
+		}
+		else
+		{
+			// Contexts belong to threads, so each search makes its own, and it makes its children alone.
+			portfolio<TSP::node> race;
+			for(auto const &NAME : names)
+				race.add(NAME, [&, NAME]
+				{
+					context<tsp_instance> const SEARCH_CONTEXT(INSTANCE);
+					TSPProblem const PROBLEM(INITIAL);
+					return SEARCHES(NAME, PROBLEM);
+				});
+			thread_pool pool(names.size());
+			SOLUTION = race.run(pool);
+			cout << "winner: " << race.winner() << "\n";
+		}
 
 		cout << "solution: { ";
 		for_each(begin(SOLUTION->state()), end(SOLUTION->state()), [&](typename TSP::state::const_reference I)
@@ -165,7 +294,6 @@ Graph procedural(size_t const &n, mt19937::result_type const &SEED)
 #ifndef NDEBUG
 	ofstream dot("TSP.dot");
 	boost::write_graphviz(dot, g, boost::default_writer(), boost::make_label_writer(boost::get(&EdgeProps::cost, g)));
-#endif
 
 	pair<vertex_iter, vertex_iter> const VP = boost::vertices(g);
 	cout << "vertices: ";
@@ -179,6 +307,7 @@ Graph procedural(size_t const &n, mt19937::result_type const &SEED)
 	for (tie(ei, ei_end) = boost::edges(g); ei != ei_end; ++ei)
 		cout << *ei << ": "<< g[*ei].cost << "  ";
 	cout << std::endl;
+#endif
 	
 	return g;
 }
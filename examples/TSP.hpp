@@ -19,19 +19,40 @@
 #ifndef TSP_H
 #define TSP_H
 
+#include "to_string.hpp"
+
+
+template <typename Edge, typename Memo>
+class edge_list;
+
+// The nodes print their states with jwm::to_string, so it must be declared before problem.hpp.
+namespace jwm
+{
+	template <typename Edge, typename Memo>
+	std::string to_string(edge_list<Edge, Memo> const &LIST);
+}
+
 #include "problem.hpp"
 #include "evaluation.hpp"
-#include "to_string.hpp"
+#include "instance_file.hpp"
 
 #include <set>
 #include <vector>
 #include <algorithm>
+#include <numeric>
 #include <stdexcept>
 #include <array>
 #include <string>
 #include <memory>
 #include <stdexcept>
 #include <sstream>
+#include <iterator>
+#include <functional>
+#include <cstddef>
+#include <tuple>
+#include <limits>
+#include <cmath>
+#include <ostream>
 
 #ifndef NDEBUG
 #include <iostream>
@@ -39,8 +60,7 @@
 
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/adjacency_matrix.hpp>
-#include <boost/graph/depth_first_search.hpp>
-#include <boost/graph/adjacency_list.hpp>
+#include <boost/range/iterator_range.hpp>
 
 using boost::adjacency_matrix;
 
@@ -85,72 +105,503 @@ typedef typename boost::graph_traits<Graph>::edge_descriptor edge_desc;
 
 typedef typename boost::graph_traits<Graph>::out_edge_iterator out_edge_iterator;
 
-vertices_size_type n; // Size of the TSP instance (number of cities).
-edges_size_type N; // Size of the TSP instance (number of edges).
+// An edge of the complete graph of a TSP instance, with u < v.
+struct tsp_edge
+{
+	tsp_edge(unsigned int const U, unsigned int const V, unsigned int const COST) : u(U), v(V), cost(COST) {}
+
+	unsigned int u, v;
+	unsigned int cost;
+};
+
+
+inline std::string to_string(tsp_edge const &EDGE)
+{
+	return "(" + std::to_string(EDGE.u) + "," + std::to_string(EDGE.v) + ")";
+}
+
+
+inline std::ostream &operator<<(std::ostream &stream, tsp_edge const &EDGE)
+{
+	return stream << to_string(EDGE);
+}
+
+
+// One TSP instance: the matrix of distances between the cities and its edges in order of increasing cost.
+// The policies find the instance they are solving through jsearch::context<tsp_instance>.
+// An instance only refers to its arrays, which are either its own or in a file mapped into memory (see
+// instance_file.hpp); it shares ownership of them.  States refer to the edges by pointer.
+struct tsp_instance
+{
+	typedef boost::iterator_range<unsigned int const *> cost_range;
+	typedef boost::iterator_range<tsp_edge const *> edge_range;
+
+	// COST is the DIMENSION × DIMENSION distance matrix in row-major order.
+	tsp_instance(vertices_size_type const DIMENSION, std::vector<unsigned int> &&COST) : tsp_instance(owned::make(DIMENSION, std::move(COST)), DIMENSION) {}
+
+	explicit tsp_instance(Graph const &GRAPH) : tsp_instance(boost::num_vertices(GRAPH), to_matrix(GRAPH)) {}
+
+	// Arrays that STORAGE keeps alive, as the constructors above make them: the matrix
+	// and the DIMENSION × (DIMENSION - 1) / 2 edges sorted by cost.
+	tsp_instance(std::shared_ptr<void const> const &STORAGE, vertices_size_type const DIMENSION, unsigned int const *MATRIX, tsp_edge const *EDGES) : n(DIMENSION), N(DIMENSION * (DIMENSION - 1) / 2), matrix(MATRIX, MATRIX + n * n), edges(EDGES, EDGES + N), storage(STORAGE) {}
+
+	tsp_instance(tsp_instance const &) = delete;
+	tsp_instance &operator=(tsp_instance const &) = delete;
+
+	unsigned int cost(vertex_desc const U, vertex_desc const V) const { return matrix[U * n + V]; }
+
+	vertices_size_type const n; // Number of cities.
+	edges_size_type const N; // Number of edges.
+	cost_range const matrix;
+	edge_range const edges; // Sorted by cost.
+
+private:
+	struct owned
+	{
+		static std::shared_ptr<owned const> make(vertices_size_type const n, std::vector<unsigned int> &&COST)
+		{
+			if(COST.size() != n * n)
+				throw std::invalid_argument("tsp_instance: the cost matrix is not " + std::to_string(n) + " × " + std::to_string(n));
+
+			auto const RESULT(std::make_shared<owned>());
+			RESULT->matrix = std::move(COST);
+			auto &edges(RESULT->edges);
+			edges.reserve(n * (n - 1) / 2);
+			for(unsigned int u(0); u < n; ++u)
+				for(unsigned int v(u + 1); v < n; ++v)
+					edges.emplace_back(u, v, RESULT->matrix[u * n + v]);
+			std::sort(std::begin(edges), std::end(edges), [](tsp_edge const &A, tsp_edge const &B)
+			{
+				return A.cost < B.cost;
+			});
+			return RESULT;
+		}
+
+		std::vector<unsigned int> matrix;
+		std::vector<tsp_edge> edges;
+	};
+
+	tsp_instance(std::shared_ptr<owned const> const &ARRAYS, vertices_size_type const DIMENSION) : tsp_instance(ARRAYS, DIMENSION, ARRAYS->matrix.data(), ARRAYS->edges.data()) {}
+
+	static std::vector<unsigned int> to_matrix(Graph const &GRAPH)
+	{
+		auto const SIZE(boost::num_vertices(GRAPH));
+		std::vector<unsigned int> result(SIZE * SIZE, 0);
+		auto const EP(boost::edges(GRAPH));
+		std::for_each(EP.first, EP.second, [&](edge_desc const &E)
+		{
+			auto const U(boost::source(E, GRAPH)), V(boost::target(E, GRAPH));
+			result[U * SIZE + V] = result[V * SIZE + U] = GRAPH[E].cost;
+		});
+		return result;
+	}
+
+	std::shared_ptr<void const> storage;
+};
+
+// The edges of a partial tour as a persistent list, most recent edge first.
+// A child shares all of its parent's edges and adds one cell, so making a child and storing it are
+// both O(1) regardless of depth.  The size and hash are kept in each cell for the same reason.
+// Each cell also has a Memo in which a heuristic may keep what it learnt about the state.
+template <typename Edge, typename Memo = std::tuple<>>
+class edge_list
+{
+	struct cell
+	{
+		cell(Edge const &EDGE, std::shared_ptr<cell const> const &TAIL, std::size_t const SIZE, std::size_t const HASH) : edge(EDGE), tail(TAIL), size(SIZE), hash(HASH) {}
+
+		Edge edge;
+		std::shared_ptr<cell const> tail;
+		std::size_t size, hash;
+		mutable Memo memo;
+	};
+
+public:
+	typedef Edge value_type;
+	typedef Edge const &const_reference;
+	typedef std::size_t size_type;
+
+	class const_iterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef Edge value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Edge const *pointer;
+		typedef Edge const &reference;
+
+		const_iterator(cell const *CELL = nullptr) : position(CELL) {}
+
+		Edge const &operator*() const { return position->edge; }
+		Edge const *operator->() const { return &position->edge; }
+		const_iterator &operator++() { position = position->tail.get(); return *this; }
+		const_iterator operator++(int) { auto const TMP(*this); ++*this; return TMP; }
+		bool operator==(const_iterator const &OTHER) const { return position == OTHER.position; }
+		bool operator!=(const_iterator const &OTHER) const { return position != OTHER.position; }
+
+	private:
+		cell const *position;
+	};
+
+	edge_list() {}
+
+	// The list of TAIL's edges plus EDGE.
+	edge_list(edge_list const &TAIL, Edge const &EDGE) : head(std::make_shared<cell const>(EDGE, TAIL.head, TAIL.size() + 1, TAIL.hash() * 31 + std::hash<typename std::iterator_traits<Edge>::value_type const *>()(&*EDGE))) {}
+
+	bool empty() const { return !head; }
+	size_type size() const { return head ? head->size : 0; }
+	std::size_t hash() const { return head ? head->hash : 0; }
+
+	// The most recently added edge.
+	Edge const &back() const { return head->edge; }
+
+	// The list without its most recent edge: the parent state.
+	edge_list tail() const { return edge_list(head->tail); }
+
+	// Not part of the value of the state, so it may be changed even through a const list.
+	// The empty list has nowhere to keep one.
+	Memo *memo() const { return head ? &head->memo : nullptr; }
+
+	const_iterator begin() const { return const_iterator(head.get()); }
+	const_iterator end() const { return const_iterator(); }
+
+	bool operator==(edge_list const &OTHER) const
+	{
+		return size() == OTHER.size() && hash() == OTHER.hash() && std::equal(begin(), end(), OTHER.begin());
+	}
+
+	bool operator!=(edge_list const &OTHER) const { return !(*this == OTHER); }
+
+	// Any total order will do for tie-breaking.
+	bool operator<(edge_list const &OTHER) const
+	{
+		return size() != OTHER.size() ? size() < OTHER.size() : std::lexicographical_compare(begin(), end(), OTHER.begin(), OTHER.end(), [](Edge const &A, Edge const &B){ return &*A < &*B; });
+	}
+
+	bool operator>(edge_list const &OTHER) const { return OTHER < *this; }
+
+private:
+	explicit edge_list(std::shared_ptr<cell const> const &HEAD) : head(HEAD) {}
+
+	std::shared_ptr<cell const> head;
+};
+
+
+namespace std
+{
+	template <typename Edge, typename Memo>
+	struct hash<edge_list<Edge, Memo>>
+	{
+		size_t operator()(edge_list<Edge, Memo> const &LIST) const { return LIST.hash(); }
+	};
+}
+
+
+namespace jwm
+{
+	template <typename Edge, typename Memo>
+	std::string to_string(edge_list<Edge, Memo> const &LIST)
+	{
+		std::string result("{");
+		for(auto const &EDGE : LIST)
+			result += (result.size() > 1 ? " " : "") + to_string(*EDGE);
+		return result + "}";
+	}
+}
+
+
+// What OneTreeBound remembers about a state: its value and the multipliers that achieved it,
+// from which the state's children start.
+struct one_tree_memo
+{
+	one_tree_memo() : bounded(false), h(0) {}
+
+	bool bounded;
+	unsigned int h;
+	std::vector<float> pi;
+};
+
+
+template <typename Traits>
+class OneTreeBound;
 
-std::unique_ptr<Graph> problem;
-std::vector<edge_desc> EDGES;
 
 // Problem definition
 struct TSP
 {
-	typedef typename std::vector<edge_desc>::const_iterator action;
-	typedef std::vector<action> state; // Why vector again?  Remind me?  Why not set?  Do I really need back()?
+	typedef tsp_instance instance;
+	typedef tsp_edge const *action;
+	typedef edge_list<action, one_tree_memo> state;
 	typedef unsigned int cost;
 	typedef unsigned int pathcost;
-	typedef std::shared_ptr<jsearch::ComboNode<TSP>> node;
+	typedef std::shared_ptr<jsearch::HeuristicComboNode<TSP, OneTreeBound>> node; // Bounded once, when generated.
 };
 
 
-// TSP heuristic: shortest imaginable tour including these edges.
 template <typename Traits>
-class MinimalImaginableTour
+class EdgeCost
 {
 public:
 	typedef typename Traits::state State;
+	typedef typename Traits::action Action;
 	typedef typename Traits::pathcost PathCost;
 	
 protected:
-	MinimalImaginableTour() {}
-	~MinimalImaginableTour() {}
+	EdgeCost() {}
+	~EdgeCost() {}
 	
-	PathCost h(State const &STATE) const
+	PathCost step_cost(State const &, Action const &ACTION) const
 	{
-		// Expects edge costs to be ordered.
-		auto const EMPTY(STATE.empty());
-		auto const LAST(STATE.back());
-		auto const START(EMPTY ? std::begin(EDGES) : LAST + 1);
-		auto const END(START + n - STATE.size());
+		PathCost const RESULT(ACTION->cost);
+		return RESULT;
+	}
+};
+
 
-		PathCost const RESULT(std::accumulate(START, END, 0, [&](PathCost const &A, edge_desc const &B)
+// The path fragments formed by the edges of a state: the degree of each city and, by union-find,
+// which fragment it is on.  An edge extends the state towards a tour if neither of its ends already
+// has two edges and, unless it is the edge that closes the tour, its ends are on different fragments.
+class fragments
+{
+public:
+	template <typename State>
+	fragments(tsp_instance const &INSTANCE, State const &STATE) : degree(INSTANCE.n, 0), rank(INSTANCE.n, 0), parent(INSTANCE.n)
+	{
+		std::iota(std::begin(parent), std::end(parent), 0);
+		std::for_each(std::begin(STATE), std::end(STATE), [&](typename State::const_reference E)
 		{
-			return A + (*problem)[B].cost;
-		}));
-		
-		return RESULT;
+			join(E->u, E->v);
+		});
 	}
+
+	bool extends_tour(vertex_desc const U, vertex_desc const V, bool const CLOSING)
+	{
+		return degree[U] < 2 && degree[V] < 2 && (CLOSING || find(U) != find(V));
+	}
+
+private:
+	void join(vertex_desc const U, vertex_desc const V)
+	{
+		++degree[U];
+		++degree[V];
+		auto a(find(U)), b(find(V));
+		if(a == b)
+			return;
+		if(rank[a] < rank[b])
+			std::swap(a, b);
+		parent[b] = a;
+		if(rank[a] == rank[b])
+			++rank[a];
+	}
+
+	vertex_desc find(vertex_desc v)
+	{
+		// Path halving.
+		while(parent[v] != v)
+			v = parent[v] = parent[parent[v]];
+		return v;
+	}
+
+	std::vector<unsigned char> degree, rank;
+	std::vector<vertex_desc> parent;
 };
 
 
+// TSP heuristic: the Held-Karp lower bound.  The cheapest 1-tree (a spanning tree of cities 1..n-1
+// plus two edges at city 0) that contains the edges of the state and uses only edges that can still
+// be added to it is a lower bound on any tour that completes the state.  Adding a multiplier pi[v] to
+// the cost of every edge at v changes every tour by the same 2 * sum(pi) but not every 1-tree, so
+// subgradient optimisation of pi on the degree constraints tightens the bound, often to the optimum.
+//
+// The multipliers that gave a state its bound are kept in its memo, and its children start from them:
+// they differ by one edge, so a few iterations recover most of the bound.
 template <typename Traits>
-class EdgeCost
+class OneTreeBound
 {
 public:
 	typedef typename Traits::state State;
-	typedef typename Traits::action Action;
 	typedef typename Traits::pathcost PathCost;
-	
+
 protected:
-	EdgeCost() {}
-	~EdgeCost() {}
-	
-	PathCost step_cost(State const &, Action const &ACTION) const
+	OneTreeBound() {}
+	~OneTreeBound() {}
+
+	PathCost h(State const &STATE) const
 	{
-		PathCost const RESULT((*problem)[*ACTION].cost);
-		return RESULT;
+		auto const MEMO(STATE.memo());
+		if(MEMO && MEMO->bounded)
+			return MEMO->h;
+
+		auto const &INSTANCE(jsearch::context<typename Traits::instance>::get());
+		auto const n(INSTANCE.n);
+		auto const PARENT(STATE.empty() ? nullptr : STATE.tail().memo());
+		bool const WARM(PARENT && PARENT->bounded && !PARENT->pi.empty());
+		std::vector<float> pi(WARM ? PARENT->pi : std::vector<float>(n, 0.0f)), best_pi(pi);
+		std::vector<candidate> fixed, free;
+		PathCost g(0);
+		partition(INSTANCE, STATE, fixed, free, g);
+
+		double best(-std::numeric_limits<double>::infinity()), lambda(2.0);
+		std::vector<unsigned> degree(n);
+		auto const ITERATIONS(WARM ? WARM_ITERATIONS : COLD_ITERATIONS);
+
+		for(unsigned i(0), stalled(0); i < ITERATIONS; ++i)
+		{
+			double const L(one_tree(n, fixed, free, pi, degree));
+			if(std::isinf(L))
+				return remember(MEMO, INFEASIBLE, std::move(pi));
+
+			if(L > best)
+			{
+				best = L;
+				best_pi = pi;
+				stalled = 0;
+			}
+			else if(++stalled == 5)
+			{
+				lambda /= 2;
+				stalled = 0;
+			}
+
+			double norm(0);
+			for(auto const D : degree)
+				norm += (static_cast<double>(D) - 2) * (static_cast<double>(D) - 2);
+			if(norm == 0) // The 1-tree is a tour: the bound is exact.
+				break;
+
+			double const T(lambda * std::max(1.0, 0.02 * std::abs(best)) / norm);
+			for(vertices_size_type v(0); v < n; ++v)
+				pi[v] += T * (static_cast<double>(degree[v]) - 2);
+		}
+
+		// Edge costs are integers, so the bound on the tour can be rounded up.
+		double const TOUR(std::ceil(best - 1e-6));
+		PathCost const RESULT(TOUR > g ? static_cast<PathCost>(TOUR) - g : 0);
+		return remember(MEMO, RESULT, std::move(best_pi));
+	}
+
+private:
+	static constexpr unsigned COLD_ITERATIONS = 50, WARM_ITERATIONS = 10;
+	static constexpr PathCost INFEASIBLE = std::numeric_limits<PathCost>::max() / 2; // Leaves room for g.
+
+	struct candidate
+	{
+		candidate(vertex_desc const U, vertex_desc const V, unsigned int const COST) : u(U), v(V), cost(COST), weight(0) {}
+
+		vertex_desc u, v;
+		unsigned int cost;
+		double weight;
+	};
+
+	static PathCost remember(one_tree_memo *memo, PathCost const H, std::vector<float> &&pi)
+	{
+		if(memo)
+		{
+			memo->bounded = true;
+			memo->h = H;
+			memo->pi = std::move(pi);
+		}
+		return H;
+	}
+
+	// Split the edges into those fixed by STATE and those that could still be added to it.
+	static void partition(tsp_instance const &INSTANCE, State const &STATE, std::vector<candidate> &fixed, std::vector<candidate> &free, PathCost &g)
+	{
+		std::for_each(std::begin(STATE), std::end(STATE), [&](typename State::const_reference E)
+		{
+			fixed.emplace_back(E->u, E->v, E->cost);
+			g += fixed.back().cost;
+		});
+
+		fragments partial(INSTANCE, STATE);
+		bool const CLOSING(STATE.size() == INSTANCE.n - 1);
+		for(auto edge(STATE.empty() ? std::begin(INSTANCE.edges) : STATE.back() + 1); edge != std::end(INSTANCE.edges); ++edge)
+		{
+			if(partial.extends_tour(edge->u, edge->v, CLOSING))
+				free.emplace_back(edge->u, edge->v, edge->cost);
+		}
+	}
+
+	// The cost of the cheapest 1-tree under multipliers PI, infinite if there is none, and its degrees.
+	static double one_tree(vertices_size_type const n, std::vector<candidate> const &FIXED, std::vector<candidate> &free, std::vector<float> const &PI, std::vector<unsigned> &degree)
+	{
+		std::vector<vertex_desc> parent(n);
+		std::iota(std::begin(parent), std::end(parent), 0);
+		auto const FIND([&](vertex_desc v)
+		{
+			while(parent[v] != v)
+				v = parent[v] = parent[parent[v]];
+			return v;
+		});
+
+		std::fill(std::begin(degree), std::end(degree), 0);
+		double total(0);
+		vertices_size_type tree_edges(0), zero_edges(0);
+		auto const TAKE([&](candidate const &E)
+		{
+			total += E.cost + PI[E.u] + PI[E.v];
+			++degree[E.u];
+			++degree[E.v];
+		});
+
+		// Fixed edges first.  They form paths, so among cities 1..n-1 they never form a cycle.
+		for(auto const &E : FIXED)
+		{
+			TAKE(E);
+			if(E.u == 0 || E.v == 0)
+				++zero_edges;
+			else
+			{
+				parent[FIND(E.u)] = FIND(E.v);
+				++tree_edges;
+			}
+		}
+
+		for(auto &E : free)
+			E.weight = E.cost + PI[E.u] + PI[E.v];
+		std::sort(std::begin(free), std::end(free), [](candidate const &A, candidate const &B){ return A.weight < B.weight; });
+
+		// Kruskal for the spanning tree of 1..n-1 and the cheapest edges to make up two at city 0.
+		for(auto const &E : free)
+		{
+			if(E.u == 0 || E.v == 0)
+			{
+				if(zero_edges < 2)
+				{
+					TAKE(E);
+					++zero_edges;
+				}
+			}
+			else if(tree_edges < n - 2)
+			{
+				auto const A(FIND(E.u)), B(FIND(E.v));
+				if(A != B)
+				{
+					parent[A] = B;
+					TAKE(E);
+					++tree_edges;
+				}
+			}
+		}
+
+		if(tree_edges != n - 2 || zero_edges != 2)
+			return std::numeric_limits<double>::infinity();
+
+		for(auto const P : PI)
+			total -= 2.0 * P;
+		return total;
 	}
 };
 
+template <typename Traits>
+constexpr unsigned OneTreeBound<Traits>::COLD_ITERATIONS;
+
+template <typename Traits>
+constexpr unsigned OneTreeBound<Traits>::WARM_ITERATIONS;
+
+template <typename Traits>
+constexpr typename OneTreeBound<Traits>::PathCost OneTreeBound<Traits>::INFEASIBLE;
+
 
 // This actually has to do the bulk of the work in the algorithm.
 template <typename Traits>
@@ -160,10 +611,6 @@ public:
 	typedef typename Traits::state State;
 	typedef typename Traits::action Action;
 
-private:
-	// subgraph is used for testing whether a given combination of edges form a valid subsection of a tour.
-	typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> subgraph;
-	
 protected:
 	HigherCostValidEdges(){}
 	~HigherCostValidEdges(){}
@@ -174,8 +621,9 @@ protected:
 	std::vector<Action> actions(State const &STATE) const
 	{
 		std::vector<Action> result;
-		auto const START(STATE.empty() ? EDGES.cbegin() : STATE.back() + 1),
-					END(EDGES.cbegin() + N - n + STATE.size() + 1);
+		auto const &INSTANCE(jsearch::context<typename Traits::instance>::get());
+		auto const START(STATE.empty() ? std::begin(INSTANCE.edges) : STATE.back() + 1),
+					END(std::begin(INSTANCE.edges) + INSTANCE.N - INSTANCE.n + STATE.size() + 1);
 #ifndef NDEBUG
 		std::cout << "Generating actions for state: {";
 		std::for_each(std::begin(STATE), std::end(STATE), [&](typename State::const_reference ACTION){ std::cout << *ACTION; });
@@ -183,94 +631,13 @@ protected:
 #endif
 		if(STATE.size() > 1)
 		{
-			// Create a graph containing all the edges in STATE.
-			subgraph subproblem;
-			
-			std::for_each(std::begin(STATE), std::end(STATE), [&](typename State::const_reference &E)
-			{
-				auto const SOURCE(boost::source(*E, *problem)),
-						   TARGET(boost::target(*E, *problem));
-				// Use the vertices from the main problem in the subproblem.
-				auto const RESULT(boost::add_edge(SOURCE, TARGET, subproblem));
-				if(!RESULT.second)
-				{
-					std::ostringstream tmp;
-					tmp << "  ERROR: Failed to add edge " << RESULT.first << " to subgraph.\n";
-					throw std::logic_error(tmp.str());
-				}
-			});
-			
+			// Each candidate costs O(α(n)) with no allocation: the fragments are built once per expansion.
+			fragments partial(INSTANCE, STATE);
+			bool const CLOSING(STATE.size() == INSTANCE.n - 1);
 
 			for(auto edge(START); edge != END; ++edge)
-			{
-				// Add candidate action to the subgraph.
-				auto const SOURCE(boost::source(*edge, *problem)),
-							TARGET(boost::target(*edge, *problem));
-				auto const ADD_EDGE_RESULT(boost::add_edge(SOURCE, TARGET, subproblem));
-				if(!ADD_EDGE_RESULT.second)
-				{
-					std::ostringstream tmp;
-					tmp << "  ERROR: Failed to add edge " << ADD_EDGE_RESULT.first << " to subgraph.\n";
-					throw std::logic_error(tmp.str());
-				}
-				// Check the graph for validity.
-				bool valid(true);
-
-				auto degree(boost::out_degree(SOURCE, subproblem));
-				if(degree > 2)
-				{
-					valid = false;
-#ifndef NDEBUG
-					auto const EI(boost::out_edges(SOURCE, subproblem));
-					std::set<boost::graph_traits<subgraph>::edge_descriptor> const invalid(EI.first, EI.second);
-					std::cout << "  !invalid SOURCE edge: " << *edge << " on " << SOURCE << ". " << jwm::to_string(invalid) << "\n";
-#endif
-				}
-				else
-				{
-					degree = boost::out_degree(TARGET, subproblem);
-
-					if(degree > 2)
-					{
-						valid = false;
-#ifndef NDEBUG
-						auto const EI(boost::out_edges(TARGET, subproblem));
-						std::set<boost::graph_traits<subgraph>::edge_descriptor> const invalid(EI.first, EI.second);
-						std::cout << "  !invalid TARGET edge: " << *edge << " on " << TARGET << ". " << jwm::to_string(invalid) << "\n";
-#endif
-					}
-					else
-					{
-						if(STATE.size() != n - 1)
-						{
-							cycle_detector vis;
-
-							try
-							{
-								boost::depth_first_search(subproblem, boost::visitor(vis));
-							}
-							catch (found_cycle &ex)
-							{
-								valid = false;
-#ifndef NDEBUG
-								std::cout << "  !cycle found: " << *edge << "\n";
-#endif
-							}
-						}
-					}
-				}
-
-				// If valid, add action to result.
-				if(valid)
-				{
-#ifndef NDEBUG
-					std::cout << "  GOOD edge: " << *edge << "\n";
-#endif
+				if(partial.extends_tour(edge->u, edge->v, CLOSING))
 					result.push_back(edge);
-				}
-				// Remove action from subgraph.
-				boost::remove_edge(ADD_EDGE_RESULT.first, subproblem);
-			}
 		}
 		else
 		{
@@ -280,41 +647,13 @@ protected:
 		}
 
 #ifndef NDEBUG
-		std::vector<edge_desc> tmp;
+		std::vector<tsp_edge> tmp;
 		tmp.reserve(result.size());
 		std::for_each(std::begin(result), std::end(result), [&](Action const &A){ tmp.push_back(*A); });
 		std::cout << "  Actions: " << jwm::to_string(tmp) << "\n";
 #endif
 		return result;
 	}
-
-private:
-	class found_cycle : public std::exception
-	{
-	public:
-		found_cycle(subgraph::edge_descriptor const &EDGE) : edge(EDGE) {};
-		subgraph::edge_descriptor const edge;
-	};
-
-	struct cycle_detector : public boost::dfs_visitor<>
-	{
-		template <class Edge, class Graph>
-		void back_edge(Edge const &E, Graph&)
-		{
-			// Throw an exception so that the algorithm stops searching.
-			if(predecessors.find(E) == std::end(predecessors))
-				throw found_cycle(E);
-		}
-		
-		template <class Edge, class Graph>
-		void tree_edge(Edge const &E, Graph &)
-		{
-			predecessors.insert(E);
-		}
-	private:
-		// TODO: Find a way to make this a hash/unordered set.
-		std::set<subgraph::edge_descriptor> predecessors;
-	};
 };
 
 
@@ -332,9 +671,7 @@ protected:
 	
 	State result(State const &PARENT, Action const &ACTION) const
 	{
-		State child(PARENT);
-		child.push_back(ACTION);
-		return child;
+		return State(PARENT, ACTION);
 	}
 };
 
@@ -353,8 +690,34 @@ protected:
 	
 	bool goal_test(State const &STATE) const
 	{
-		return STATE.size() == n;
+		return STATE.size() == jsearch::context<typename Traits::instance>::get().n;
 	}
 };
 
+
+namespace instance_file
+{
+	static_assert(std::is_trivially_copyable<tsp_edge>::value && sizeof(tsp_edge) == 3 * sizeof(unsigned int), "Edges are written as they are.");
+
+	// The matrix and the sorted edges, so that loading does not sort.
+	inline void write(std::string const &PATH, tsp_instance const &INSTANCE)
+	{
+		detail::write(PATH, kind::TSP, INSTANCE.n, INSTANCE.N, {{std::begin(INSTANCE.matrix), INSTANCE.matrix.size()}, {std::begin(INSTANCE.edges), INSTANCE.edges.size()}});
+	}
+
+
+	/**
+	 * The TSP instance in the file at PATH, which refers to the mapped file.
+	 * Throws std::runtime_error, or format_error naming the file.
+	 */
+	inline std::unique_ptr<tsp_instance> read_tsp(std::string const &PATH)
+	{
+		detail::reader const SOURCE(PATH, kind::TSP, 2);
+		auto const n(SOURCE.count(0)), N(SOURCE.count(1));
+		if(N != n * (n - 1) / 2)
+			SOURCE.fail("the number of edges does not match the number of cities.");
+		return std::unique_ptr<tsp_instance>(new tsp_instance(SOURCE.storage(), n, SOURCE.array<unsigned int>(0, n * n), SOURCE.array<tsp_edge>(1, N)));
+	}
+}
+
 #endif // TSP_H
@@ -0,0 +1,202 @@
+/*
+    csr_graph.hpp: Compressed sparse row graphs and search policies over them.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file csr_graph.hpp
+ * @brief A weighted graph as three flat arrays, for graphs too large for an adjacency matrix.
+ *
+ * It models enough of Boost.Graph to be searched with the policies of graph.hpp,
+ * with weights_map() as the weight map.
+ *
+ * The arcs out of vertex v are offsets[v] .. offsets[v + 1] - 1 and arc e goes to
+ * targets[e] at cost weights[e].  An undirected edge is a pair of arcs.  Memory is
+ * O(n + m), and expanding a vertex reads two contiguous runs of its arcs.
+ *
+ * A graph only refers to its arrays; it shares ownership of whatever holds them,
+ * which is either vectors of its own or a file mapped into memory (see
+ * instance_file.hpp).  Copies are therefore cheap and share the arrays.
+ */
+
+#ifndef CSR_GRAPH_HPP
+#define CSR_GRAPH_HPP
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+#include <boost/range/iterator_range.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/property_map/property_map.hpp>
+
+
+template <typename Weight, typename Vertex = std::uint32_t, typename Arc = std::size_t>
+class csr_graph
+{
+public:
+	typedef Vertex vertex;
+	typedef Arc arc;
+	typedef Weight weight_type;
+	typedef boost::iterator_range<boost::counting_iterator<Arc>> arc_range;
+	typedef boost::iterator_property_map<Weight const *, boost::typed_identity_property_map<Arc>> weight_map;
+
+	csr_graph() : csr_graph(std::vector<Arc>(1, 0), std::vector<Vertex>(), std::vector<Weight>()) {}
+
+	// OFFSETS has one entry per vertex plus one; TARGETS and WEIGHTS have one per arc.
+	csr_graph(std::vector<Arc> &&OFFSETS, std::vector<Vertex> &&TARGETS, std::vector<Weight> &&WEIGHTS)
+	{
+		auto const ARRAYS(std::make_shared<owned>(std::move(OFFSETS), std::move(TARGETS), std::move(WEIGHTS)));
+		if(ARRAYS->offsets.empty() || ARRAYS->targets.size() != ARRAYS->weights.size())
+			throw std::invalid_argument("csr_graph: inconsistent arrays.");
+		assign(ARRAYS, ARRAYS->offsets.size() - 1, ARRAYS->targets.size(), ARRAYS->offsets.data(), ARRAYS->targets.data(), ARRAYS->weights.data());
+	}
+
+	// Arrays that STORAGE keeps alive: N + 1 offsets, and M targets and weights.
+	// Only the first and last offsets are checked, so that nothing else need be read.
+	csr_graph(std::shared_ptr<void const> const &STORAGE, Vertex const N, Arc const M, Arc const *OFFSETS, Vertex const *TARGETS, Weight const *WEIGHTS)
+	{
+		assign(STORAGE, N, M, OFFSETS, TARGETS, WEIGHTS);
+	}
+
+	Vertex num_vertices() const { return n; }
+	Arc num_arcs() const { return m; }
+
+	arc_range out_arcs(Vertex const V) const
+	{
+		return boost::make_iterator_range(boost::counting_iterator<Arc>(offsets[V]), boost::counting_iterator<Arc>(offsets[V + 1]));
+	}
+
+	Arc out_degree(Vertex const V) const { return offsets[V + 1] - offsets[V]; }
+	Vertex target(Arc const E) const { return targets[E]; }
+	Weight const &weight(Arc const E) const { return weights[E]; }
+
+	// The source of an arc is not stored: it is found by binary search of the offsets.
+	Vertex source(Arc const E) const
+	{
+		return std::upper_bound(offsets, offsets + n + 1, E) - offsets - 1;
+	}
+
+	weight_map weights_map() const { return weight_map(weights); }
+
+	// The arrays themselves, for writing the graph out.
+	Arc const *offset_array() const { return offsets; }
+	Vertex const *target_array() const { return targets; }
+	Weight const *weight_array() const { return weights; }
+
+private:
+	struct owned
+	{
+		owned(std::vector<Arc> &&OFFSETS, std::vector<Vertex> &&TARGETS, std::vector<Weight> &&WEIGHTS) : offsets(std::move(OFFSETS)), targets(std::move(TARGETS)), weights(std::move(WEIGHTS)) {}
+
+		std::vector<Arc> offsets;
+		std::vector<Vertex> targets;
+		std::vector<Weight> weights;
+	};
+
+	void assign(std::shared_ptr<void const> const &STORAGE, Vertex const N, Arc const M, Arc const *OFFSETS, Vertex const *TARGETS, Weight const *WEIGHTS)
+	{
+		if(OFFSETS[0] != 0 || OFFSETS[N] != M)
+			throw std::invalid_argument("csr_graph: inconsistent arrays.");
+		storage = STORAGE;
+		n = N;
+		m = M;
+		offsets = OFFSETS;
+		targets = TARGETS;
+		weights = WEIGHTS;
+	}
+
+	std::shared_ptr<void const> storage;
+	Vertex n;
+	Arc m;
+	Arc const *offsets;
+	Vertex const *targets;
+	Weight const *weights;
+};
+
+
+// Enough of the Boost.Graph IncidenceGraph and VertexListGraph concepts for the policies of graph.hpp.
+namespace boost
+{
+	template <typename Weight, typename Vertex, typename Arc>
+	struct graph_traits<csr_graph<Weight, Vertex, Arc>>
+	{
+		typedef Vertex vertex_descriptor;
+		typedef Arc edge_descriptor;
+		typedef boost::counting_iterator<Arc> out_edge_iterator;
+		typedef boost::counting_iterator<Vertex> vertex_iterator;
+		typedef directed_tag directed_category;
+		typedef disallow_parallel_edge_tag edge_parallel_category;
+		struct traversal_category : incidence_graph_tag, vertex_list_graph_tag {};
+		typedef Vertex vertices_size_type;
+		typedef Arc edges_size_type;
+		typedef Arc degree_size_type;
+
+		static Vertex null_vertex() { return std::numeric_limits<Vertex>::max(); }
+	};
+}
+
+
+template <typename Weight, typename Vertex, typename Arc>
+std::pair<boost::counting_iterator<Arc>, boost::counting_iterator<Arc>> out_edges(Vertex const V, csr_graph<Weight, Vertex, Arc> const &G)
+{
+	auto const RANGE(G.out_arcs(V));
+	return std::make_pair(std::begin(RANGE), std::end(RANGE));
+}
+
+
+template <typename Weight, typename Vertex, typename Arc>
+Arc out_degree(Vertex const V, csr_graph<Weight, Vertex, Arc> const &G)
+{
+	return G.out_degree(V);
+}
+
+
+template <typename Weight, typename Vertex, typename Arc>
+Vertex source(Arc const E, csr_graph<Weight, Vertex, Arc> const &G)
+{
+	return G.source(E);
+}
+
+
+template <typename Weight, typename Vertex, typename Arc>
+Vertex target(Arc const E, csr_graph<Weight, Vertex, Arc> const &G)
+{
+	return G.target(E);
+}
+
+
+template <typename Weight, typename Vertex, typename Arc>
+std::pair<boost::counting_iterator<Vertex>, boost::counting_iterator<Vertex>> vertices(csr_graph<Weight, Vertex, Arc> const &G)
+{
+	return std::make_pair(boost::counting_iterator<Vertex>(0), boost::counting_iterator<Vertex>(G.num_vertices()));
+}
+
+
+template <typename Weight, typename Vertex, typename Arc>
+Vertex num_vertices(csr_graph<Weight, Vertex, Arc> const &G)
+{
+	return G.num_vertices();
+}
+
+#endif // CSR_GRAPH_HPP
@@ -26,8 +26,13 @@
 #include <type_traits>
 #include <algorithm>
 #include <stdexcept>
+#include <vector>
+#include <utility>
+#include <cstdint>
 #include <boost/graph/adjacency_matrix.hpp>
 
+#include "csr_graph.hpp"
+
 #ifndef NDEBUG
 #include <boost/graph/graphviz.hpp>
 #include <fstream>
@@ -122,4 +127,73 @@ namespace gg
 		boost::write_graphviz(gv_output, g, boost::default_writer(), boost::make_label_writer(boost::get(boost::edge_weight, g)));
 #endif
 	}
+
+
+	/**
+	 * The same graph as generate_graph() with the same engine, as a csr_graph.
+	 *
+	 * Weights are drawn in the same order, including for the edges that generate_graph
+	 * finds already present and drops, and each vertex lists its arcs in order of target
+	 * like the adjacency matrix does, so a search sees exactly the same graph in O(n·b)
+	 * memory instead of O(n²).
+	 */
+	template <typename Weight, typename Engine>
+	csr_graph<Weight> generate_csr_graph(std::uint32_t const N, unsigned const B, Engine engine)
+	{
+		Detail::check_preconditions(N, B);
+
+		typename std::conditional<std::is_integral<Weight>::value, std::uniform_int_distribution<Weight>, std::uniform_real_distribution<Weight>>::type weight_dist(1, 500);
+		auto weight_generator(std::bind(weight_dist, engine));
+
+		// Every vertex has degree B, so the rows are all the same length.
+		std::vector<std::size_t> offsets(N + 1);
+		for(std::uint32_t v(0); v <= N; ++v)
+			offsets[v] = static_cast<std::size_t>(v) * B;
+		std::vector<std::uint32_t> targets(offsets.back()), degree(N, 0);
+		std::vector<Weight> weights(offsets.back());
+
+		auto const ARC([&](std::uint32_t const U, std::uint32_t const V, Weight const &W)
+		{
+			if(degree[U] == B)
+				throw std::logic_error("Vertex degree exceeds the branching factor.");
+			auto const E(offsets[U] + degree[U]++);
+			targets[E] = V;
+			weights[E] = W;
+		});
+
+		auto const BODD(B % 2);
+		auto const	END(N / 2 + BODD + N % 2),
+					START(END - B / 2 - BODD); // Intentional integer division rounding on B.
+		for(std::uint32_t v(0); v < N; ++v)
+			for(unsigned i(START); i < END; ++i)
+			{
+				Weight const W(weight_generator());
+				std::uint32_t const U((v + i) % N);
+				// An earlier vertex U already added this edge if v is its neighbour at offset N - i.
+				bool const DUPLICATE(U < v && N - i >= START && N - i < END);
+				if(!DUPLICATE)
+				{
+					ARC(v, U, W);
+					ARC(U, v, W);
+				}
+			}
+
+		std::vector<std::pair<std::uint32_t, Weight>> row;
+		for(std::uint32_t v(0); v < N; ++v)
+		{
+			if(degree[v] != B)
+				throw std::logic_error("Vertex degree differs from the branching factor.");
+			row.clear();
+			for(auto e(offsets[v]); e != offsets[v + 1]; ++e)
+				row.emplace_back(targets[e], weights[e]);
+			std::sort(std::begin(row), std::end(row), [](std::pair<std::uint32_t, Weight> const &A, std::pair<std::uint32_t, Weight> const &B_){ return A.first < B_.first; });
+			for(std::size_t k(0); k != row.size(); ++k)
+			{
+				targets[offsets[v] + k] = row[k].first;
+				weights[offsets[v] + k] = row[k].second;
+			}
+		}
+
+		return csr_graph<Weight>(std::move(offsets), std::move(targets), std::move(weights));
+	}
 }
@@ -0,0 +1,261 @@
+/*
+    grid.cpp: Grid pathfinding on the Moving AI benchmarks, with and without Jump Point Search.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grid.hpp"
+#include "movingai.hpp"
+#include "bestfirstsearch.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <cstdlib>
+#include <unordered_set>
+#include <unordered_map>
+#include <boost/heap/d_ary_heap.hpp>
+
+using namespace std;
+using namespace jsearch;
+
+
+template <typename Traits>
+using CostFunction = AStar<Traits, Octile>;
+
+template <typename Traits>
+using TieBreaking = LowH<Traits, Octile>;
+
+template <typename Traits>
+using Comparator = TiebreakingComparator<Traits, CostFunction, TieBreaking>;
+
+template <typename T, typename Comp>
+using PriorityQueue = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>, boost::heap::arity<2>, boost::heap::compare<Comp>>;
+
+template <typename Key, typename Value>
+using Map = std::unordered_map<Key, Value>;
+
+template <typename T>
+using ClosedList = std::unordered_set<T>;
+
+
+// Octile distance inflated by half: weighted A*, which may close a cell before its best path is found.
+template <typename Traits>
+class WeightedOctile : protected Octile<Traits>
+{
+public:
+	typedef typename Traits::state State;
+	typedef typename Traits::pathcost PathCost;
+
+protected:
+	WeightedOctile() {}
+	~WeightedOctile() {}
+
+	PathCost h(State const &STATE) const
+	{
+		return 1.5 * Octile<Traits>::h(STATE);
+	}
+};
+
+template <typename Traits>
+using WeightedCost = AStar<Traits, WeightedOctile>;
+
+template <typename Traits>
+using WeightedComparator = SimpleComparator<Traits, WeightedCost>;
+
+// The Bound of BoundedReopen is not a parameter of a ClosedPolicy, so it is given here.
+template <typename Traits, template <typename T> class Set, template <typename Key, typename Value> class Map>
+using ReopenOnce = BoundedReopen<Traits, Set, Map, 1>;
+
+
+// Greedy search on two heuristics that disagree, for multi_queue_search.
+template <typename Traits>
+using GreedyOctileCost = Greedy<Traits, Octile>;
+
+template <typename Traits>
+using GreedyOctile = SimpleComparator<Traits, GreedyOctileCost>;
+
+template <typename Traits>
+using GreedyDifferentialCost = Greedy<Traits, Differential>;
+
+template <typename Traits>
+using GreedyDifferential = SimpleComparator<Traits, GreedyDifferentialCost>;
+
+
+// best_first_search with SearchComparator and ClosedPolicy.
+template <template <typename Traits> class SearchComparator,
+		template <typename Traits, template <typename T> class Set, template <typename Key, typename Value> class Map> class ClosedPolicy = NeverReopen>
+struct graph_search
+{
+	template <class Problem>
+	double operator()(Problem const &PROBLEM, vector<grid_state> &path) const
+	{
+		return best_first_search<PriorityQueue, SearchComparator, ClosedList, Map, ClosedPolicy>(PROBLEM, back_inserter(path));
+	}
+};
+
+
+// multi_queue_search taking turns between greedy search on Octile and on the differential heuristic.
+struct two_queue_search
+{
+	template <class Problem>
+	double operator()(Problem const &PROBLEM, vector<grid_state> &path) const
+	{
+		return multi_queue_search<PriorityQueue, ClosedList, Map, GreedyOctile, GreedyDifferential>(PROBLEM, back_inserter(path));
+	}
+};
+
+
+// The length of the shortest path from FROM to every cell of MAP, infinite if there is none.
+vector<double> distances(grid_map const &MAP, grid_map::cell const FROM)
+{
+	grid_instance const INSTANCE(MAP, FROM); // The goal test is not used.
+	context<grid_instance> const CONTEXT(INSTANCE);
+	Problem<Grid, MoveCost, GridMoves, MoveTo, AtGoal> const PROBLEM((grid_state(FROM)));
+	Map<grid_state, Grid::node> settled;
+	shortest_path_tree<PriorityQueue, Map>(PROBLEM, settled);
+
+	vector<double> result(MAP.cells(), numeric_limits<double>::infinity());
+	for(auto const &SETTLED : settled)
+		result[SETTLED.first.cell] = SETTLED.second->path_cost();
+	return result;
+}
+
+
+// The cell farthest from FROM, which sees the most of the map along its shortest paths.
+grid_map::cell farthest(grid_map const &MAP, grid_map::cell const FROM)
+{
+	auto const DISTANCE(distances(MAP, FROM));
+	grid_map::cell result(FROM);
+	for(grid_map::cell c(0); c < DISTANCE.size(); ++c)
+		if(!std::isinf(DISTANCE[c]) && DISTANCE[c] > DISTANCE[result])
+			result = c;
+	return result;
+}
+
+
+struct totals
+{
+	totals() : expanded(0), seconds(0), length(0), optimal(0), wrong(0) {}
+
+	size_t expanded;
+	double seconds;
+	double length, optimal; // The sums of the path lengths found and of the optimal ones.
+	unsigned wrong; // Scenarios whose path length differs from the optimal one.
+};
+
+
+// Solve every scenario with ActionsPolicy by Search, and add to RESULT.
+// Unless EXACT, the search is not expected to find optimal paths and they are only summed.
+template <template <typename Traits> class ActionsPolicy, class Search = graph_search<Comparator>>
+void run(grid_map const &MAP, vector<movingai::scenario> const &SCENARIOS, totals &result, bool const EXACT = true)
+{
+	Search const SEARCH;
+
+	for(auto const &S : SCENARIOS)
+	{
+		grid_instance const INSTANCE(MAP, MAP.at(S.goal_x, S.goal_y));
+		context<grid_instance> const CONTEXT(INSTANCE);
+		Problem<Grid, MoveCost, ActionsPolicy, MoveTo, AtGoal> const PROBLEM(grid_state(MAP.at(S.start_x, S.start_y)));
+		vector<grid_state> path;
+		double length(-1);
+
+		auto const T0(chrono::steady_clock::now());
+		try
+		{
+			length = SEARCH(PROBLEM, path);
+		}
+		catch(goal_not_found const &)
+		{
+		}
+		result.seconds += chrono::duration<double>(chrono::steady_clock::now() - T0).count();
+		result.expanded += INSTANCE.expanded;
+		result.length += length;
+		result.optimal += S.optimal;
+
+		// The scenario files give lengths to eight decimal places.
+		if(EXACT && abs(length - S.optimal) > 1e-6 * max(1.0, S.optimal))
+		{
+			++result.wrong;
+			cerr << "(" << S.start_x << "," << S.start_y << ") to (" << S.goal_x << "," << S.goal_y << "): " << setprecision(10) << length << ", not " << S.optimal << "\n";
+		}
+	}
+}
+
+
+int main(int argc, char **argv)
+{
+	if(argc != 3)
+	{
+		cerr << "Invocation: grid <map file> <scenario file>\n";
+		exit(EXIT_FAILURE);
+	}
+
+	try
+	{
+		auto const MAP(movingai::load_map(argv[1]));
+		auto const SCENARIOS(movingai::load_scenarios(argv[2]));
+		for(auto const &S : SCENARIOS)
+			if(S.width != MAP.width() || S.height != MAP.height())
+				throw movingai::parse_error(string(argv[2]) + ": scenarios for a map of another size.");
+
+		cout << "map: " << argv[1] << " (" << MAP.width() << " × " << MAP.height() << "), scenarios: " << SCENARIOS.size() << "\n";
+
+		totals astar, jps, never, once, always, greedy, differential, two_queues;
+		run<GridMoves>(MAP, SCENARIOS, astar);
+		run<JumpPoints>(MAP, SCENARIOS, jps);
+		// Weighted A* with each closed list policy.
+		run<GridMoves, graph_search<WeightedComparator, NeverReopen>>(MAP, SCENARIOS, never, false);
+		run<GridMoves, graph_search<WeightedComparator, ReopenOnce>>(MAP, SCENARIOS, once, false);
+		run<GridMoves, graph_search<WeightedComparator, AlwaysReopen>>(MAP, SCENARIOS, always, false);
+		// Greedy search on each heuristic, and on both in two queues.
+		run<GridMoves, graph_search<GreedyOctile>>(MAP, SCENARIOS, greedy, false);
+		// The landmark is the cell farthest from a start, which is probably on the main part of the map.
+		if(!SCENARIOS.empty())
+		{
+			auto const &FIRST(SCENARIOS.front());
+			auto const LANDMARK(farthest(MAP, MAP.at(FIRST.start_x, FIRST.start_y)));
+			grid_landmark const DIFFERENTIAL(LANDMARK, distances(MAP, LANDMARK));
+			context<grid_landmark> const CONTEXT(DIFFERENTIAL);
+			run<GridMoves, graph_search<GreedyDifferential>>(MAP, SCENARIOS, differential, false);
+			run<GridMoves, two_queue_search>(MAP, SCENARIOS, two_queues, false);
+		}
+
+		cout << left << setw(16) << "" << right << setw(12) << "expanded" << setw(12) << "ms" << setw(8) << "wrong" << setw(10) << "length" << "\n";
+		auto const ROW([](string const &NAME, totals const &T)
+		{
+			cout << left << setw(16) << NAME << right << setw(12) << T.expanded << setw(12) << fixed << setprecision(1) << T.seconds * 1000 << setw(8) << T.wrong << setw(10) << setprecision(4) << T.length / T.optimal << "\n";
+		});
+		ROW("A*", astar);
+		ROW("JPS", jps);
+		ROW("wA*", never);
+		ROW("wA*, reopen 1", once);
+		ROW("wA*, reopen", always);
+		ROW("greedy", greedy);
+		ROW("greedy, diff.", differential);
+		ROW("2 queues", two_queues);
+
+		return astar.wrong || jps.wrong ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+	catch(runtime_error const &EX)
+	{
+		cerr << EX.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+}
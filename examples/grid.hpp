@@ -0,0 +1,478 @@
+/*
+    grid.hpp: Pathfinding on 8-connected grid maps, with Jump Point Search.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file grid.hpp
+ * @brief The grid domain: a map of passable and blocked cells, moves to the eight neighbours of a cell.
+ *
+ * Straight moves cost 1 and diagonal moves cost √2.  A diagonal move may not cut
+ * a corner: both of the cells it passes between must be passable.  These are
+ * the rules of the Moving AI benchmarks, so their optimal lengths apply.
+ *
+ * Two ActionsPolicy classes are provided: GridMoves, which moves to every
+ * passable neighbour, and JumpPoints, Jump Point Search (Harabor and Grastien
+ * 2011, in the form without corner cutting), which prunes the symmetric
+ * orderings of the same moves and jumps straight to the next cell at which a
+ * path could turn.  Both are optimal with A* and the Octile heuristic.
+ */
+
+#ifndef GRID_HPP
+#define GRID_HPP
+
+#include "problem.hpp"
+#include "to_string.hpp"
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <string>
+#include <ostream>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <limits>
+#include <utility>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include <boost/container/static_vector.hpp>
+
+
+typedef std::uint8_t direction;
+
+// N, E, S, W, then NE, SE, SW, NW: the straight directions come first.
+direction const NONE = 8;
+std::array<int, 8> const DX {{0, 1, 0, -1, 1, 1, -1, -1}}, DY {{-1, 0, 1, 0, -1, 1, 1, -1}};
+
+inline bool diagonal(direction const D) { return D >= 4; }
+
+
+/**
+ * Passability, one bit per cell.  The map is surrounded by a border of blocked
+ * cells, so a neighbour of any cell on the map exists and needs no bounds check.
+ * A cell is its index in the bordered map, row by row.
+ */
+class grid_map
+{
+public:
+	typedef std::uint32_t cell;
+
+	// A WIDTH × HEIGHT map with every cell blocked.
+	grid_map(unsigned int const WIDTH, unsigned int const HEIGHT) : width_(WIDTH), height_(HEIGHT), stride(WIDTH + 2), bits((std::uint64_t(stride) * (HEIGHT + 2) + 63) / 64, 0)
+	{
+		if(std::uint64_t(stride) * (HEIGHT + 2) > std::numeric_limits<cell>::max())
+			throw std::invalid_argument("grid_map: too large.");
+		for(direction d(0); d < 8; ++d)
+			offsets[d] = DY[d] * std::ptrdiff_t(stride) + DX[d];
+	}
+
+	unsigned int width() const { return width_; }
+	unsigned int height() const { return height_; }
+
+	cell at(unsigned int const X, unsigned int const Y) const { return (Y + 1) * stride + X + 1; }
+	unsigned int x(cell const C) const { return C % stride - 1; }
+	unsigned int y(cell const C) const { return C / stride - 1; }
+
+	bool passable(cell const C) const { return bits[C >> 6] >> (C & 63) & 1; }
+
+	void set_passable(unsigned int const X, unsigned int const Y)
+	{
+		auto const C(at(X, Y));
+		bits[C >> 6] |= std::uint64_t(1) << (C & 63);
+	}
+
+	cell neighbour(cell const C, direction const D) const { return C + offsets[D]; }
+
+	// One more than the largest cell, border included: the size of an array indexed by cell.
+	std::size_t cells() const { return std::size_t(stride) * (height_ + 2); }
+
+	// Whether one can move from C to its neighbour in direction D without cutting a corner.
+	bool can_move(cell const C, direction const D) const
+	{
+		return passable(neighbour(C, D)) && (!diagonal(D) || (passable(C + DX[D]) && passable(C + DY[D] * std::ptrdiff_t(stride))));
+	}
+
+	// The length of the shortest unobstructed path between A and B.
+	double octile(cell const A, cell const B) const
+	{
+		auto const DELTA_X(x(A) > x(B) ? x(A) - x(B) : x(B) - x(A)), DELTA_Y(y(A) > y(B) ? y(A) - y(B) : y(B) - y(A));
+		auto const MINMAX(std::minmax(DELTA_X, DELTA_Y));
+		return (MINMAX.second - MINMAX.first) + SQRT2 * MINMAX.first;
+	}
+
+	static constexpr double SQRT2 = 1.4142135623730951;
+
+private:
+	unsigned int width_, height_, stride;
+	std::array<std::ptrdiff_t, 8> offsets;
+	std::vector<std::uint64_t> bits;
+};
+
+constexpr double grid_map::SQRT2;
+
+
+// One query on a map.  The policies find it through jsearch::context<grid_instance>.
+struct grid_instance
+{
+	grid_instance(grid_map const &MAP, grid_map::cell const GOAL) : map(MAP), goal(GOAL), expanded(0) {}
+
+	grid_instance(grid_instance const &) = delete;
+	grid_instance &operator=(grid_instance const &) = delete;
+
+	grid_map const &map;
+	grid_map::cell const goal;
+	mutable std::size_t expanded; // Counted by the ActionsPolicy.
+};
+
+
+// A cell, and the direction in which the search arrived at it.  The direction is
+// what Jump Point Search prunes by, but it is not part of the value of the state:
+// two states in the same cell are equal, so the search keeps one path to a cell.
+struct grid_state
+{
+	grid_state(grid_map::cell const CELL = 0, direction const FROM = NONE) : cell(CELL), from(FROM) {}
+
+	grid_map::cell cell;
+	direction from;
+};
+
+inline bool operator==(grid_state const &A, grid_state const &B) { return A.cell == B.cell; }
+inline bool operator!=(grid_state const &A, grid_state const &B) { return A.cell != B.cell; }
+
+// The search prints states with jwm::to_string, so this must be declared before the search header is included.
+namespace jwm
+{
+	inline std::string to_string(grid_state const &STATE)
+	{
+		auto const &MAP(jsearch::context<grid_instance>::get().map);
+		return "(" + std::to_string(MAP.x(STATE.cell)) + "," + std::to_string(MAP.y(STATE.cell)) + ")";
+	}
+}
+
+inline std::ostream &operator<<(std::ostream &stream, grid_state const &STATE)
+{
+	return stream << jwm::to_string(STATE);
+}
+
+namespace std
+{
+	template <>
+	struct hash<grid_state>
+	{
+		size_t operator()(grid_state const &STATE) const { return hash<grid_map::cell>()(STATE.cell); }
+	};
+}
+
+
+// A move, or a jump of several moves in one direction.
+struct grid_move
+{
+	grid_move(grid_map::cell const TO = 0, direction const D = NONE, double const COST = 0) : to(TO), d(D), cost(COST) {}
+
+	grid_map::cell to;
+	direction d;
+	double cost;
+};
+
+
+struct Grid
+{
+	typedef grid_instance instance;
+	typedef grid_state state;
+	typedef grid_move action;
+	typedef double cost;
+	typedef cost pathcost;
+	typedef std::shared_ptr<jsearch::DefaultNode<Grid>> node;
+};
+
+
+template <typename Traits>
+class MoveCost
+{
+public:
+	typedef typename Traits::state State;
+	typedef typename Traits::action Action;
+	typedef typename Traits::pathcost PathCost;
+
+protected:
+	MoveCost() {}
+	~MoveCost() {}
+
+	PathCost step_cost(State const &, Action const &ACTION) const
+	{
+		return ACTION.cost;
+	}
+};
+
+
+// Every move from a cell, with no pruning.
+template <typename Traits>
+class GridMoves
+{
+public:
+	typedef typename Traits::state State;
+	typedef typename Traits::action Action;
+	typedef boost::container::static_vector<Action, 8> Actions;
+
+protected:
+	GridMoves() {}
+	~GridMoves() {}
+
+	Actions actions(State const &STATE) const
+	{
+		auto const &INSTANCE(jsearch::context<typename Traits::instance>::get());
+		auto const &MAP(INSTANCE.map);
+		++INSTANCE.expanded;
+
+		Actions result;
+		for(direction d(0); d < 8; ++d)
+			if(MAP.can_move(STATE.cell, d))
+				result.emplace_back(MAP.neighbour(STATE.cell, d), d, diagonal(d) ? grid_map::SQRT2 : 1.0);
+		return result;
+	}
+};
+
+
+/**
+ * Jump Point Search.  Of the neighbours of a cell, only those that an optimal
+ * path arriving in the direction it did could need next are considered: the
+ * natural neighbours, straight on (and, on a diagonal, its two components), and
+ * the forced neighbours, those to the side of a straight move that could not
+ * be reached from the previous cell because an obstacle is in the way.  From
+ * each of them the search jumps on in the same direction until it reaches the
+ * goal or a cell that has forced neighbours of its own; only those cells are
+ * generated.
+ */
+template <typename Traits>
+class JumpPoints
+{
+public:
+	typedef typename Traits::state State;
+	typedef typename Traits::action Action;
+	typedef boost::container::static_vector<Action, 8> Actions;
+
+protected:
+	JumpPoints() {}
+	~JumpPoints() {}
+
+	Actions actions(State const &STATE) const
+	{
+		auto const &INSTANCE(jsearch::context<typename Traits::instance>::get());
+		auto const &MAP(INSTANCE.map);
+		auto const C(STATE.cell);
+		++INSTANCE.expanded;
+
+		Actions result;
+		auto const JUMP([&](direction const D)
+		{
+			auto const J(jump(INSTANCE, MAP.neighbour(C, D), D));
+			if(J != NO_CELL)
+				result.emplace_back(J, D, MAP.octile(C, J));
+		});
+
+		if(STATE.from == NONE) // The start: every direction.
+		{
+			for(direction d(0); d < 8; ++d)
+				if(MAP.can_move(C, d))
+					JUMP(d);
+		}
+		else if(diagonal(STATE.from))
+		{
+			auto const H(horizontal(STATE.from)), V(vertical(STATE.from));
+			bool const H_OPEN(MAP.passable(MAP.neighbour(C, H))), V_OPEN(MAP.passable(MAP.neighbour(C, V)));
+			if(H_OPEN)
+				JUMP(H);
+			if(V_OPEN)
+				JUMP(V);
+			if(H_OPEN && V_OPEN && MAP.passable(MAP.neighbour(C, STATE.from)))
+				JUMP(STATE.from);
+		}
+		else
+		{
+			auto const D(STATE.from);
+			bool const AHEAD(MAP.passable(MAP.neighbour(C, D)));
+			if(AHEAD)
+				JUMP(D);
+			for(auto const P : perpendicular(D))
+				if(forced(MAP, C, D, P))
+				{
+					JUMP(P);
+					if(AHEAD && MAP.passable(MAP.neighbour(C, combine(D, P))))
+						JUMP(combine(D, P));
+				}
+		}
+
+		return result;
+	}
+
+private:
+	static constexpr grid_map::cell NO_CELL = std::numeric_limits<grid_map::cell>::max();
+
+	static direction horizontal(direction const D) { return DX[D] > 0 ? 1 : 3; }
+	static direction vertical(direction const D) { return DY[D] > 0 ? 2 : 0; }
+
+	static std::array<direction, 2> perpendicular(direction const D)
+	{
+		return D % 2 ? std::array<direction, 2>{{0, 2}} : std::array<direction, 2>{{1, 3}};
+	}
+
+	// The diagonal direction of straight directions A and B.
+	static direction combine(direction const A, direction const B)
+	{
+		static direction const DIAGONAL[4][4] = {{NONE, 4, NONE, 7}, {4, NONE, 5, NONE}, {NONE, 5, NONE, 6}, {7, NONE, 6, NONE}};
+		return DIAGONAL[A][B];
+	}
+
+	// Whether the neighbour of C in straight direction P is forced when moving in straight direction D.
+	static bool forced(grid_map const &MAP, grid_map::cell const C, direction const D, direction const P)
+	{
+		return MAP.passable(MAP.neighbour(C, P)) && !MAP.passable(MAP.neighbour(MAP.neighbour(C, P), D ^ 2)); // D ^ 2 is the opposite of D.
+	}
+
+	// The first jump point from C onwards in direction D, or NO_CELL.
+	static grid_map::cell jump(grid_instance const &INSTANCE, grid_map::cell c, direction const D)
+	{
+		auto const &MAP(INSTANCE.map);
+
+		for(;; c = MAP.neighbour(c, D))
+		{
+			if(!MAP.passable(c))
+				return NO_CELL;
+			if(c == INSTANCE.goal)
+				return c;
+
+			if(diagonal(D))
+			{
+				auto const H(horizontal(D)), V(vertical(D));
+				if(jump(INSTANCE, MAP.neighbour(c, H), H) != NO_CELL || jump(INSTANCE, MAP.neighbour(c, V), V) != NO_CELL)
+					return c;
+				if(!MAP.passable(MAP.neighbour(c, H)) || !MAP.passable(MAP.neighbour(c, V)))
+					return NO_CELL; // Going on would cut a corner.
+			}
+			else
+			{
+				auto const P(perpendicular(D));
+				if(forced(MAP, c, D, P[0]) || forced(MAP, c, D, P[1]))
+					return c;
+			}
+		}
+	}
+};
+
+template <typename Traits>
+constexpr grid_map::cell JumpPoints<Traits>::NO_CELL;
+
+
+template <typename Traits>
+class MoveTo
+{
+public:
+	typedef typename Traits::state State;
+	typedef typename Traits::action Action;
+
+protected:
+	MoveTo() {}
+	~MoveTo() {}
+
+	State result(State const &, Action const &ACTION) const
+	{
+		return State(ACTION.to, ACTION.d);
+	}
+};
+
+
+template <typename Traits>
+class AtGoal
+{
+public:
+	typedef typename Traits::state State;
+
+protected:
+	AtGoal() {}
+	~AtGoal() {}
+
+	bool goal_test(State const &STATE) const
+	{
+		return STATE.cell == jsearch::context<typename Traits::instance>::get().goal;
+	}
+};
+
+
+// The length of the shortest path on an empty map: admissible and consistent.
+template <typename Traits>
+class Octile
+{
+public:
+	typedef typename Traits::state State;
+	typedef typename Traits::pathcost PathCost;
+
+protected:
+	Octile() {}
+	~Octile() {}
+
+	PathCost h(State const &STATE) const
+	{
+		auto const &INSTANCE(jsearch::context<typename Traits::instance>::get());
+		return INSTANCE.map.octile(STATE.cell, INSTANCE.goal);
+	}
+};
+
+
+// The lengths of the shortest paths from one cell, the landmark, to every cell.
+// The Differential heuristic finds it through jsearch::context<grid_landmark>.
+struct grid_landmark
+{
+	grid_landmark(grid_map::cell const CELL, std::vector<double> &&DISTANCE) : cell(CELL), distance(std::move(DISTANCE)) {}
+
+	grid_landmark(grid_landmark const &) = delete;
+	grid_landmark &operator=(grid_landmark const &) = delete;
+
+	grid_map::cell const cell;
+	std::vector<double> const distance; // Indexed by cell, infinite where the landmark cannot reach.
+};
+
+
+/**
+ * The differential heuristic: by the triangle inequality the difference between
+ * the distances of a cell and of the goal from the landmark is a lower bound on
+ * the distance between them.  Admissible and consistent, and unlike Octile it
+ * knows about walls, so the two disagree most where the map is cluttered: it is
+ * exact along the paths through the landmark and uninformed across them.
+ */
+template <typename Traits>
+class Differential
+{
+public:
+	typedef typename Traits::state State;
+	typedef typename Traits::pathcost PathCost;
+
+protected:
+	Differential() {}
+	~Differential() {}
+
+	PathCost h(State const &STATE) const
+	{
+		auto const &DISTANCE(jsearch::context<grid_landmark>::get().distance);
+		auto const CELL(DISTANCE[STATE.cell]), GOAL(DISTANCE[jsearch::context<typename Traits::instance>::get().goal]);
+		// If either cannot be reached from the landmark there is no bound to be had.
+		return std::isinf(CELL) || std::isinf(GOAL) ? 0 : std::abs(CELL - GOAL);
+	}
+};
+
+#endif // GRID_HPP
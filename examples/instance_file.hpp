@@ -0,0 +1,255 @@
+/*
+    instance_file.hpp: A binary file format for graphs and problem instances.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file instance_file.hpp
+ * @brief Write instances as their arrays and load them by mapping the file, without copying or parsing.
+ *
+ * A file is a header followed by the instance's arrays, each at an offset that
+ * is a multiple of ALIGNMENT, so that once the file is mapped each array can be
+ * used where it lies.  Loading is therefore O(1) regardless of the size of the
+ * instance, and the pages of the file are read as the search touches them.
+ *
+ * The header records the kind of instance, the format version, the byte order
+ * and the size and type of the elements of every array, and a loader rejects a
+ * file that differs from what it expects in any of them.  Loaders check only
+ * what they can without reading the arrays: a damaged file with an intact
+ * header is not detected.
+ *
+ * This header does graphs (csr_graph); TSP.hpp does TSP instances.
+ */
+
+#ifndef INSTANCE_FILE_HPP
+#define INSTANCE_FILE_HPP
+
+#include "mapped_file.hpp"
+#include "csr_graph.hpp"
+
+#include <string>
+#include <memory>
+#include <fstream>
+#include <initializer_list>
+#include <type_traits>
+#include <limits>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace instance_file
+{
+	enum class kind : std::uint32_t { GRAPH = 1, TSP = 2 };
+
+	std::uint32_t const VERSION = 1;
+	std::size_t const ALIGNMENT = 64;
+
+
+	class format_error : public std::runtime_error
+	{
+	public:
+		explicit format_error(std::string const &WHAT) : std::runtime_error(WHAT) {}
+	};
+
+
+	namespace detail
+	{
+		char const MAGIC[8] = {'J', 'S', 'E', 'A', 'R', 'C', 'H', '\0'};
+		std::uint32_t const ENDIAN_MARK = 0x01020304;
+		std::size_t const MAX_SECTIONS = 4;
+
+		struct section
+		{
+			std::uint64_t offset, size; // In bytes from the start of the file.
+			std::uint32_t element_size, element_type;
+		};
+
+		struct header
+		{
+			char magic[8];
+			std::uint32_t byte_order, version, kind, section_count;
+			std::uint64_t count[2]; // The dimensions of the instance, as the kind defines them.
+			section sections[MAX_SECTIONS];
+		};
+
+		static_assert(sizeof(section) == 24 && sizeof(header) == 40 + MAX_SECTIONS * sizeof(section), "The header is laid out without padding.");
+
+
+		// Enough to tell the arrays of one instantiation from those of another.
+		template <typename T>
+		std::uint32_t element_type()
+		{
+			return std::is_floating_point<T>::value ? 'f' : std::is_signed<T>::value ? 'i' : std::is_integral<T>::value ? 'u' : 'r';
+		}
+
+
+		struct array
+		{
+			template <typename T>
+			array(T const *DATA, std::uint64_t const COUNT) : data(DATA), size(COUNT * sizeof(T)), element_size(sizeof(T)), element_type(detail::element_type<T>())
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable elements can be written as they are.");
+			}
+
+			void const *data;
+			std::uint64_t size;
+			std::uint32_t element_size, element_type;
+		};
+
+
+		inline std::uint64_t aligned(std::uint64_t const OFFSET)
+		{
+			return (OFFSET + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+		}
+
+
+		inline void write(std::string const &PATH, kind const KIND, std::uint64_t const COUNT0, std::uint64_t const COUNT1, std::initializer_list<array> const ARRAYS)
+		{
+			header h;
+			std::memset(&h, 0, sizeof h);
+			std::memcpy(h.magic, MAGIC, sizeof MAGIC);
+			h.byte_order = ENDIAN_MARK;
+			h.version = VERSION;
+			h.kind = static_cast<std::uint32_t>(KIND);
+			h.section_count = ARRAYS.size();
+			h.count[0] = COUNT0;
+			h.count[1] = COUNT1;
+
+			std::uint64_t offset(aligned(sizeof h));
+			auto s(h.sections);
+			for(auto const &A : ARRAYS)
+			{
+				*s++ = section{offset, A.size, A.element_size, A.element_type};
+				offset = aligned(offset + A.size);
+			}
+
+			std::ofstream out(PATH, std::ios::binary | std::ios::trunc);
+			if(!out)
+				throw std::runtime_error(PATH + ": " + std::strerror(errno));
+
+			char const PADDING[ALIGNMENT] = {};
+			out.write(reinterpret_cast<char const *>(&h), sizeof h);
+			std::uint64_t position(sizeof h);
+			s = h.sections;
+			for(auto const &A : ARRAYS)
+			{
+				out.write(PADDING, s->offset - position);
+				out.write(static_cast<char const *>(A.data), A.size);
+				position = s++->offset + A.size;
+			}
+			out.write(PADDING, aligned(position) - position);
+
+			if(!out.flush())
+				throw std::runtime_error(PATH + ": write failed.");
+		}
+
+
+		/** A mapped file whose header has been checked, from which arrays are taken. */
+		class reader
+		{
+		public:
+			reader(std::string const &PATH, kind const KIND, std::uint32_t const SECTIONS) : path(PATH), file(std::make_shared<jsearch::mapped_file const>(PATH, MADV_NORMAL))
+			{
+				if(file->size() < sizeof h)
+					fail("too short to be an instance file.");
+				std::memcpy(&h, file->begin(), sizeof h);
+				if(std::memcmp(h.magic, MAGIC, sizeof MAGIC) != 0)
+					fail("not an instance file.");
+				if(h.byte_order != ENDIAN_MARK)
+					fail("written on a machine of the other byte order.");
+				if(h.version != VERSION)
+					fail("format version " + std::to_string(h.version) + ", not " + std::to_string(VERSION) + ".");
+				if(h.kind != static_cast<std::uint32_t>(KIND))
+					fail("not an instance of this kind.");
+				if(h.section_count != SECTIONS)
+					fail("wrong number of arrays.");
+			}
+
+			std::uint64_t count(std::size_t const I) const { return h.count[I]; }
+
+			// Array I, which must have COUNT elements of type T.
+			template <typename T>
+			T const *array(std::size_t const I, std::uint64_t const COUNT) const
+			{
+				auto const &S(h.sections[I]);
+				if(S.element_size != sizeof(T) || S.element_type != element_type<T>())
+					fail("array " + std::to_string(I) + " has elements of another type.");
+				if(S.size != COUNT * sizeof(T))
+					fail("array " + std::to_string(I) + " is the wrong size.");
+				if(S.offset % ALIGNMENT != 0 || S.offset > file->size() || S.size > file->size() - S.offset)
+					fail("array " + std::to_string(I) + " is misplaced.");
+				return reinterpret_cast<T const *>(file->begin() + S.offset);
+			}
+
+			std::shared_ptr<void const> storage() const { return file; }
+
+			void fail(std::string const &WHAT) const
+			{
+				throw format_error(path + ": " + WHAT);
+			}
+
+		private:
+			std::string const path;
+			std::shared_ptr<jsearch::mapped_file const> const file;
+			header h;
+		};
+	}
+
+
+	/** Whether the file at PATH begins as an instance file does. */
+	inline bool is_instance_file(std::string const &PATH)
+	{
+		char magic[sizeof detail::MAGIC];
+		std::ifstream in(PATH, std::ios::binary);
+		return in.read(magic, sizeof magic) && std::memcmp(magic, detail::MAGIC, sizeof magic) == 0;
+	}
+
+
+	template <typename Weight, typename Vertex, typename Arc>
+	void write(std::string const &PATH, csr_graph<Weight, Vertex, Arc> const &GRAPH)
+	{
+		auto const N(GRAPH.num_vertices());
+		auto const M(GRAPH.num_arcs());
+		detail::write(PATH, kind::GRAPH, N, M, {{GRAPH.offset_array(), N + std::uint64_t(1)}, {GRAPH.target_array(), M}, {GRAPH.weight_array(), M}});
+	}
+
+
+	/**
+	 * The graph in the file at PATH, of type Graph: a csr_graph with the same
+	 * element types as the one that was written.  The graph refers to the mapped
+	 * file, which stays mapped for as long as any copy of the graph exists.
+	 *
+	 * Throws std::runtime_error, or format_error naming the file.
+	 */
+	template <typename Graph>
+	Graph read_graph(std::string const &PATH)
+	{
+		typedef typename Graph::vertex Vertex;
+		typedef typename Graph::arc Arc;
+		typedef typename Graph::weight_type Weight;
+
+		detail::reader const SOURCE(PATH, kind::GRAPH, 3);
+		auto const N(SOURCE.count(0)), M(SOURCE.count(1));
+		if(N >= std::numeric_limits<Vertex>::max() || M > std::numeric_limits<Arc>::max())
+			SOURCE.fail("too large for this graph type.");
+		return Graph(SOURCE.storage(), N, M, SOURCE.template array<Arc>(0, N + 1), SOURCE.template array<Vertex>(1, M), SOURCE.template array<Weight>(2, M));
+	}
+}
+
+#endif // INSTANCE_FILE_HPP
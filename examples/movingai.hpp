@@ -0,0 +1,134 @@
+/*
+    movingai.hpp: Load grid maps and scenarios in the Moving AI benchmark formats.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file movingai.hpp
+ * @brief Loaders for .map files (type octile) and version 1 .scen files.
+ *
+ * In a map, '.', 'G' and 'S' are passable and every other terrain is blocked.
+ * A scenario is one query: its start, its goal and the length of an optimal
+ * path between them with diagonal moves of √2 that do not cut corners.
+ */
+
+#ifndef MOVINGAI_HPP
+#define MOVINGAI_HPP
+
+#include "grid.hpp"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+
+namespace movingai
+{
+	class parse_error : public std::runtime_error
+	{
+	public:
+		explicit parse_error(std::string const &WHAT) : std::runtime_error(WHAT) {}
+	};
+
+
+	struct scenario
+	{
+		unsigned int bucket;
+		std::string map;
+		unsigned int width, height;
+		unsigned int start_x, start_y, goal_x, goal_y;
+		double optimal;
+	};
+
+
+	namespace detail
+	{
+		inline std::ifstream open(std::string const &PATH)
+		{
+			std::ifstream in(PATH);
+			if(!in)
+				throw std::runtime_error(PATH + ": cannot be opened.");
+			return in;
+		}
+	}
+
+
+	/** Load the map at PATH.  Throws std::runtime_error, or parse_error naming the file. */
+	inline grid_map load_map(std::string const &PATH)
+	{
+		auto in(detail::open(PATH));
+		auto const FAIL([&](std::string const &WHAT) -> parse_error { return parse_error(PATH + ": " + WHAT); });
+
+		std::string keyword, type;
+		unsigned int width(0), height(0);
+		while(in >> keyword && keyword != "map")
+		{
+			if(keyword == "type")
+				in >> type;
+			else if(keyword == "height")
+				in >> height;
+			else if(keyword == "width")
+				in >> width;
+			else
+				throw FAIL("unknown keyword " + keyword + ".");
+		}
+		if(keyword != "map")
+			throw FAIL("no map.");
+		if(type != "octile")
+			throw FAIL("type " + type + ", not octile.");
+		if(width == 0 || height == 0)
+			throw FAIL("no dimensions.");
+
+		grid_map result(width, height);
+		std::string row;
+		for(unsigned int y(0); y < height; ++y)
+		{
+			if(!(in >> row) || row.size() != width)
+				throw FAIL("row " + std::to_string(y) + " is not " + std::to_string(width) + " cells wide.");
+			for(unsigned int x(0); x < width; ++x)
+				if(row[x] == '.' || row[x] == 'G' || row[x] == 'S')
+					result.set_passable(x, y);
+		}
+		return result;
+	}
+
+
+	/** Load the scenarios at PATH.  Throws std::runtime_error, or parse_error naming the file. */
+	inline std::vector<scenario> load_scenarios(std::string const &PATH)
+	{
+		auto in(detail::open(PATH));
+		std::string line;
+		if(!std::getline(in, line) || line.compare(0, 9, "version 1") != 0)
+			throw parse_error(PATH + ": not a version 1 scenario file.");
+
+		std::vector<scenario> result;
+		for(unsigned int number(2); std::getline(in, line); ++number)
+		{
+			if(line.find_first_not_of(" \t\r") == std::string::npos)
+				continue;
+			std::istringstream fields(line);
+			scenario s;
+			if(!(fields >> s.bucket >> s.map >> s.width >> s.height >> s.start_x >> s.start_y >> s.goal_x >> s.goal_y >> s.optimal))
+				throw parse_error(PATH + ": line " + std::to_string(number) + " is not a scenario.");
+			result.push_back(s);
+		}
+		return result;
+	}
+}
+
+#endif // MOVINGAI_HPP
@@ -0,0 +1,181 @@
+/*
+    puzzle.cpp: Solve sliding-tile puzzle instances with A*, IDA* or RBFS.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "puzzle.hpp"
+#include "bestfirstsearch.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <unordered_set>
+#include <unordered_map>
+#include <boost/heap/d_ary_heap.hpp>
+
+using namespace std;
+using namespace jsearch;
+
+
+template <typename Traits>
+using CostFunction = AStar<Traits, Manhattan>;
+
+template <typename Traits>
+using TieBreaking = LowH<Traits, Manhattan>;
+
+template <typename Traits>
+using Comparator = TiebreakingComparator<Traits, CostFunction, TieBreaking>;
+
+// The memory of the A* frontier, closed list and nodes is counted per instance.
+template <typename T, typename Comp>
+using PriorityQueue = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>, boost::heap::arity<2>, boost::heap::compare<Comp>, boost::heap::allocator<tracking_allocator<T, component::FRONTIER>>>;
+
+template <typename T>
+using RBFSPriorityQueue = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>, boost::heap::arity<2>>;
+
+template <typename Key, typename Value>
+using Map = std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>, tracking_allocator<std::pair<Key const, Value>, component::INDEX>>;
+
+template <typename T>
+using ClosedList = std::unordered_set<T, std::hash<T>, std::equal_to<T>, tracking_allocator<T, component::CLOSED>>;
+
+template <typename Traits>
+using TrackedNodes = AllocatingNodeCreator<Traits, tracking_allocator<void, component::NODES>>;
+
+template <typename Traits, template <typename> class StepCost, template <typename> class Result, template <typename> class Create>
+using ManhattanChild = IncrementalChildPolicy<Traits, Manhattan, StepCost, Result, Create>;
+
+
+template <unsigned int Width>
+typename Puzzle<Width>::pathcost solve(string const &ALGORITHM, Problem<Puzzle<Width>, UnitCost, BlankMoves, SlideTile, Solved, TrackedNodes, ManhattanChild> const &PROBLEM)
+{
+	if(ALGORITHM == "astar")
+	{
+		vector<typename Puzzle<Width>::state> path;
+		return best_first_search<PriorityQueue, Comparator, ClosedList, Map>(PROBLEM, back_inserter(path));
+	}
+	else if(ALGORITHM == "ida")
+		return iterative_deepening_search<CostFunction>(PROBLEM)->path_cost();
+	else
+		return recursive_best_first_search<CostFunction, FalseTiePolicy, RBFSPriorityQueue>(PROBLEM)->path_cost();
+}
+
+
+template <unsigned int Width>
+int run(string const &ALGORITHM, string const &PATH, string const &TRACE_PATH)
+{
+	auto const INSTANCES(load_puzzles<Width>(PATH));
+	unique_ptr<trace_recorder const> const TRACE(TRACE_PATH.empty() ? nullptr : new trace_recorder(TRACE_PATH));
+	unique_ptr<context<trace_recorder> const> const TRACING(TRACE ? new context<trace_recorder>(*TRACE) : nullptr);
+	size_t expanded(0);
+	double seconds(0);
+	unsigned wrong(0);
+	memory_statistics largest;
+
+	cout << Width * Width - 1 << "-puzzle, " << ALGORITHM << ", instances: " << INSTANCES.size() << "\n";
+	for(auto const &I : INSTANCES)
+	{
+		puzzle_counters const COUNTERS;
+		context<puzzle_counters> const CONTEXT(COUNTERS);
+		memory_statistics const MEMORY;
+		context<memory_statistics> const SCOPE(MEMORY);
+		Problem<Puzzle<Width>, UnitCost, BlankMoves, SlideTile, Solved, TrackedNodes, ManhattanChild> const PROBLEM(I.initial);
+
+		auto const T0(chrono::steady_clock::now());
+		auto const LENGTH(solve<Width>(ALGORITHM, PROBLEM));
+		auto const ELAPSED(chrono::duration<double>(chrono::steady_clock::now() - T0).count());
+		expanded += COUNTERS.expanded;
+		seconds += ELAPSED;
+		if(MEMORY.total().peak > largest.total().peak)
+			largest = MEMORY;
+
+		bool const WRONG(I.optimal && LENGTH != I.optimal);
+		wrong += WRONG;
+		cout << setw(4) << I.number << ": " << setw(3) << LENGTH << (WRONG ? " (not optimal)" : "") << setw(14) << COUNTERS.expanded << " expanded" << setw(10) << fixed << setprecision(1) << ELAPSED * 1000 << " ms" << setw(10) << MEMORY.total().peak / 1024 << " KiB peak\n";
+	}
+	cout << "total: " << expanded << " expanded in " << fixed << setprecision(3) << seconds << " s, " << setprecision(0) << expanded / seconds << " expanded/s\n";
+	cout << "memory of the instance with the largest peak:\n" << largest;
+	return wrong ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+// The width of the puzzles in PATH, from the number of values in its first instance.
+unsigned int width(string const &PATH)
+{
+	ifstream in(PATH);
+	if(!in)
+		throw runtime_error(PATH + ": cannot be opened.");
+	string line;
+	while(getline(in, line))
+	{
+		auto const FIRST(line.find_first_not_of(" \t\r"));
+		if(FIRST == string::npos || line[FIRST] == '#')
+			continue;
+		istringstream fields(line);
+		unsigned int values(0);
+		for(unsigned int v; fields >> v; )
+			++values;
+		for(unsigned int w(3); w <= 5; ++w)
+			if(values == w * w + 1 || values == w * w + 2)
+				return w;
+		break;
+	}
+	throw runtime_error(PATH + ": no 8-, 15- or 24-puzzle instances.");
+}
+
+
+int main(int argc, char **argv)
+{
+	string trace;
+	if(argc > 2 && string(argv[1]) == "-t")
+	{
+		trace = argv[2];
+		argv += 2;
+		argc -= 2;
+	}
+
+	if(argc != 3 || (string(argv[1]) != "astar" && string(argv[1]) != "ida" && string(argv[1]) != "rbfs"))
+	{
+		cerr << "Invocation: puzzle [-t <trace file>] <astar | ida | rbfs> <instance file>\n"
+			"With -t, the A* searches are traced to the file for trace_summary.\n";
+		exit(EXIT_FAILURE);
+	}
+
+	try
+	{
+		switch(width(argv[2]))
+		{
+			case 3:
+				return run<3>(argv[1], argv[2], trace);
+			case 4:
+				return run<4>(argv[1], argv[2], trace);
+			default:
+				return run<5>(argv[1], argv[2], trace);
+		}
+	}
+	catch(runtime_error const &EX)
+	{
+		cerr << EX.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+}
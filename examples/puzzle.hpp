@@ -0,0 +1,438 @@
+/*
+    puzzle.hpp: The sliding-tile puzzles: 8, 15 and 24.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file puzzle.hpp
+ * @brief The Width × Width sliding-tile puzzle, with its board packed into 64-bit words.
+ *
+ * Tiles are numbered 1 .. Width² - 1 and the blank is 0.  In the goal the blank
+ * is in the top-left corner and tile i is at position i, as in Korf (1985).
+ * An action is the direction in which the blank moves; every move costs 1.
+ *
+ * The board takes 4 bits a position up to the 15-puzzle, so that one fits in a
+ * single word, and 5 bits for the 24-puzzle, which fits in two.  The Manhattan
+ * distance heuristic has the incremental form of IncrementalChildPolicy, so a
+ * child's value is its parent's adjusted for the one tile that moved.
+ */
+
+#ifndef PUZZLE_HPP
+#define PUZZLE_HPP
+
+#include "to_string.hpp"
+
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include <ostream>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+
+#include <boost/container/static_vector.hpp>
+
+
+template <unsigned int Width>
+struct puzzle_state;
+
+// The nodes print their states with jwm::to_string, so it must be declared before problem.hpp.
+namespace jwm
+{
+	template <unsigned int Width>
+	std::string to_string(puzzle_state<Width> const &STATE);
+}
+
+#include "problem.hpp"
+
+
+template <unsigned int Width>
+class puzzle_board
+{
+public:
+	typedef std::uint8_t tile;
+
+	static constexpr unsigned int SIZE = Width * Width, BITS = SIZE <= 16 ? 4 : SIZE <= 32 ? 5 : 6, WORDS = (SIZE * BITS + 63) / 64;
+
+	puzzle_board() { words.fill(0); }
+
+	tile get(unsigned int const POSITION) const
+	{
+		auto const BIT(POSITION * BITS), W(BIT / 64), OFFSET(BIT % 64);
+		auto value(words[W] >> OFFSET);
+		if(WORDS > 1 && OFFSET + BITS > 64) // The tile spans two words.
+			value |= words[W + 1] << (64 - OFFSET);
+		return value & MASK;
+	}
+
+	void set(unsigned int const POSITION, tile const TILE)
+	{
+		auto const BIT(POSITION * BITS), W(BIT / 64), OFFSET(BIT % 64);
+		words[W] = (words[W] & ~(MASK << OFFSET)) | std::uint64_t(TILE) << OFFSET;
+		if(WORDS > 1 && OFFSET + BITS > 64)
+			words[W + 1] = (words[W + 1] & ~(MASK >> (64 - OFFSET))) | std::uint64_t(TILE) >> (64 - OFFSET);
+	}
+
+	bool operator==(puzzle_board const &OTHER) const { return words == OTHER.words; }
+	bool operator!=(puzzle_board const &OTHER) const { return words != OTHER.words; }
+
+	std::size_t hash() const
+	{
+		std::uint64_t result(0);
+		for(auto const W : words)
+			result = (result ^ W) * 0x9E3779B97F4A7C15; // Fibonacci hashing spreads the low bits through the word.
+		return result ^ result >> 29;
+	}
+
+private:
+	static constexpr std::uint64_t MASK = (std::uint64_t(1) << BITS) - 1;
+
+	std::array<std::uint64_t, WORDS> words;
+};
+
+template <unsigned int Width>
+constexpr unsigned int puzzle_board<Width>::SIZE;
+
+template <unsigned int Width>
+constexpr unsigned int puzzle_board<Width>::BITS;
+
+template <unsigned int Width>
+constexpr std::uint64_t puzzle_board<Width>::MASK;
+
+
+// Up, right, down, left: D ^ 2 is the opposite of D.
+unsigned int const NO_MOVE = 4;
+
+
+// A board, and the direction of the move that made it.  The move is what the
+// actions prune by, so that no move is undone, but it is not part of the value
+// of the state; nor is the position of the blank, which the board determines.
+template <unsigned int Width>
+struct puzzle_state
+{
+	puzzle_state() : blank(0), from(NO_MOVE) {}
+
+	// TILES lists the tile at each position.
+	explicit puzzle_state(std::vector<unsigned int> const &TILES) : blank(0), from(NO_MOVE)
+	{
+		auto const SIZE(puzzle_board<Width>::SIZE);
+		std::vector<bool> seen(SIZE, false);
+		if(TILES.size() != SIZE)
+			throw std::invalid_argument("puzzle_state: not " + std::to_string(SIZE) + " tiles.");
+		for(unsigned int i(0); i < SIZE; ++i)
+		{
+			if(TILES[i] >= SIZE || seen[TILES[i]])
+				throw std::invalid_argument("puzzle_state: not a permutation of 0 .. " + std::to_string(SIZE - 1) + ".");
+			seen[TILES[i]] = true;
+			board.set(i, TILES[i]);
+			if(TILES[i] == 0)
+				blank = i;
+		}
+	}
+
+	// Whether the goal can be reached: moves keep the parity of the inversions among
+	// the tiles, plus the row of the blank if Width is even, and in the goal it is even.
+	bool solvable() const
+	{
+		unsigned int inversions(0);
+		for(unsigned int i(0); i < puzzle_board<Width>::SIZE; ++i)
+			for(unsigned int j(i + 1); j < puzzle_board<Width>::SIZE; ++j)
+				if(board.get(i) && board.get(j) && board.get(i) > board.get(j))
+					++inversions;
+		return (inversions + (Width % 2 ? 0 : blank / Width)) % 2 == 0;
+	}
+
+	puzzle_board<Width> board;
+	std::uint8_t blank, from;
+};
+
+template <unsigned int Width>
+inline bool operator==(puzzle_state<Width> const &A, puzzle_state<Width> const &B) { return A.board == B.board; }
+
+template <unsigned int Width>
+inline bool operator!=(puzzle_state<Width> const &A, puzzle_state<Width> const &B) { return A.board != B.board; }
+
+namespace jwm
+{
+	template <unsigned int Width>
+	std::string to_string(puzzle_state<Width> const &STATE)
+	{
+		std::string result("[");
+		for(unsigned int i(0); i < puzzle_board<Width>::SIZE; ++i)
+			result += (i ? " " : "") + std::to_string(STATE.board.get(i));
+		return result + "]";
+	}
+}
+
+template <unsigned int Width>
+std::ostream &operator<<(std::ostream &stream, puzzle_state<Width> const &STATE)
+{
+	return stream << jwm::to_string(STATE);
+}
+
+namespace std
+{
+	template <unsigned int Width>
+	struct hash<puzzle_state<Width>>
+	{
+		size_t operator()(puzzle_state<Width> const &STATE) const { return STATE.board.hash(); }
+	};
+}
+
+
+// What the policies count while solving.  They find it through jsearch::context<puzzle_counters>.
+struct puzzle_counters
+{
+	puzzle_counters() : expanded(0) {}
+
+	puzzle_counters(puzzle_counters const &) = delete;
+	puzzle_counters &operator=(puzzle_counters const &) = delete;
+
+	mutable std::size_t expanded;
+};
+
+
+template <typename Traits>
+class Manhattan;
+
+
+template <unsigned int Width>
+struct Puzzle
+{
+	typedef puzzle_counters instance;
+	typedef puzzle_state<Width> state;
+	typedef unsigned int action; // The direction in which the blank moves.
+	typedef unsigned int cost;
+	typedef cost pathcost;
+	typedef std::shared_ptr<jsearch::HeuristicNode<Puzzle, Manhattan>> node;
+
+	static constexpr unsigned int width = Width;
+};
+
+template <unsigned int Width>
+constexpr unsigned int Puzzle<Width>::width;
+
+
+template <typename Traits>
+class UnitCost
+{
+public:
+	typedef typename Traits::state State;
+	typedef typename Traits::action Action;
+	typedef typename Traits::pathcost PathCost;
+
+protected:
+	UnitCost() {}
+	~UnitCost() {}
+
+	PathCost step_cost(State const &, Action const &) const
+	{
+		return 1;
+	}
+};
+
+
+// Every move of the blank but the one that would undo the last move.
+template <typename Traits>
+class BlankMoves
+{
+public:
+	typedef typename Traits::state State;
+	typedef typename Traits::action Action;
+	typedef boost::container::static_vector<Action, 4> Actions;
+
+protected:
+	BlankMoves() {}
+	~BlankMoves() {}
+
+	Actions actions(State const &STATE) const
+	{
+		++jsearch::context<typename Traits::instance>::get().expanded;
+
+		auto const ROW(STATE.blank / Traits::width), COLUMN(STATE.blank % Traits::width);
+		bool const POSSIBLE[4] = {ROW > 0, COLUMN < Traits::width - 1, ROW < Traits::width - 1, COLUMN > 0};
+		Actions result;
+		for(Action d(0); d < 4; ++d)
+			if(POSSIBLE[d] && (d ^ 2) != STATE.from)
+				result.push_back(d);
+		return result;
+	}
+};
+
+
+template <typename Traits>
+class SlideTile
+{
+public:
+	typedef typename Traits::state State;
+	typedef typename Traits::action Action;
+
+protected:
+	SlideTile() {}
+	~SlideTile() {}
+
+	State result(State const &STATE, Action const &ACTION) const
+	{
+		static int const OFFSET[4] = {-int(Traits::width), 1, int(Traits::width), -1};
+		State child(STATE);
+		child.blank = STATE.blank + OFFSET[ACTION];
+		child.board.set(STATE.blank, STATE.board.get(child.blank));
+		child.board.set(child.blank, 0);
+		child.from = ACTION;
+		return child;
+	}
+};
+
+
+template <typename Traits>
+class Solved
+{
+public:
+	typedef typename Traits::state State;
+
+protected:
+	Solved() {}
+	~Solved() {}
+
+	bool goal_test(State const &STATE) const
+	{
+		static State const GOAL(goal());
+		return STATE == GOAL;
+	}
+
+private:
+	static State goal()
+	{
+		std::vector<unsigned int> tiles(Traits::width * Traits::width);
+		std::iota(std::begin(tiles), std::end(tiles), 0);
+		return State(tiles);
+	}
+};
+
+
+/**
+ * The sum over the tiles of the rows and columns between each tile and its goal.
+ * Admissible and consistent.
+ */
+template <typename Traits>
+class Manhattan
+{
+public:
+	typedef typename Traits::state State;
+	typedef typename Traits::action Action;
+	typedef typename Traits::pathcost PathCost;
+
+protected:
+	Manhattan() {}
+	~Manhattan() {}
+
+	PathCost h(State const &STATE) const
+	{
+		PathCost result(0);
+		for(unsigned int i(0); i < Traits::width * Traits::width; ++i)
+			result += distance(STATE.board.get(i), i);
+		return result;
+	}
+
+	// Only the tile that moved into the parent's blank has changed its distance.
+	PathCost h(PathCost const &PARENT_H, State const &PARENT, Action const &, State const &CHILD) const
+	{
+		auto const TILE(CHILD.board.get(PARENT.blank));
+		return PARENT_H - distance(TILE, CHILD.blank) + distance(TILE, PARENT.blank);
+	}
+
+private:
+	static unsigned int distance(unsigned int const TILE, unsigned int const POSITION)
+	{
+		static auto const TABLE(table());
+		return TABLE[TILE * Traits::width * Traits::width + POSITION];
+	}
+
+	static std::vector<std::uint8_t> table()
+	{
+		auto const W(Traits::width), SIZE(W * W);
+		std::vector<std::uint8_t> result(SIZE * SIZE, 0);
+		for(unsigned int t(1); t < SIZE; ++t) // The blank is not counted.
+			for(unsigned int p(0); p < SIZE; ++p)
+				result[t * SIZE + p] = std::abs(int(t / W) - int(p / W)) + std::abs(int(t % W) - int(p % W));
+		return result;
+	}
+};
+
+
+// One instance: a number, the initial board and, if it is known, the length of an optimal solution.
+template <unsigned int Width>
+struct puzzle_instance
+{
+	unsigned int number;
+	puzzle_state<Width> initial;
+	unsigned int optimal; // 0 if unknown.
+};
+
+
+/**
+ * Load the instances at PATH, one a line in the layout of Korf (1985): the number
+ * of the instance, then the tile at each position, then optionally the length
+ * of an optimal solution.  Lines that are empty or begin with # are skipped.
+ *
+ * Throws std::runtime_error naming the file.
+ */
+template <unsigned int Width>
+std::vector<puzzle_instance<Width>> load_puzzles(std::string const &PATH)
+{
+	std::ifstream in(PATH);
+	if(!in)
+		throw std::runtime_error(PATH + ": cannot be opened.");
+
+	std::vector<puzzle_instance<Width>> result;
+	std::string line;
+	for(unsigned int number(1); std::getline(in, line); ++number)
+	{
+		auto const FIRST(line.find_first_not_of(" \t\r"));
+		if(FIRST == std::string::npos || line[FIRST] == '#')
+			continue;
+
+		std::istringstream fields(line);
+		std::vector<unsigned int> values;
+		for(unsigned int v; fields >> v; )
+			values.push_back(v);
+
+		auto const SIZE(puzzle_board<Width>::SIZE);
+		if(values.size() != SIZE + 1 && values.size() != SIZE + 2)
+			throw std::runtime_error(PATH + ": line " + std::to_string(number) + " is not an instance of the " + std::to_string(SIZE - 1) + "-puzzle.");
+		try
+		{
+			puzzle_instance<Width> const INSTANCE{values[0], puzzle_state<Width>(std::vector<unsigned int>(std::begin(values) + 1, std::begin(values) + 1 + SIZE)), values.size() == SIZE + 2 ? values.back() : 0};
+			if(!INSTANCE.initial.solvable())
+				throw std::invalid_argument("the goal cannot be reached.");
+			result.push_back(INSTANCE);
+		}
+		catch(std::invalid_argument const &EX)
+		{
+			throw std::runtime_error(PATH + ": line " + std::to_string(number) + ": " + EX.what());
+		}
+	}
+	return result;
+}
+
+#endif // PUZZLE_HPP
@@ -20,9 +20,9 @@
 #include "problem.hpp"
 #include "bestfirstsearch.hpp"
 #include "gg.hpp"
+#include "instance_file.hpp"
 
 #include <sstream>
-#include <unordered_set>
 #include <chrono>
 #include <iostream>
 #include <algorithm>
@@ -34,17 +34,16 @@
 #include <cmath>
 #include <boost/graph/graphviz.hpp>
 #include <boost/heap/d_ary_heap.hpp>
-#include <unordered_map>
 #include <fstream>
 
 using namespace std;
 using namespace jsearch;
 
 typedef Random::state State;
-typedef Random::node Node;
 
+template <typename Node>
 string backtrace(Node const &NODE);
-void init(int argc, char **argv);
+unique_ptr<random_instance> init(int argc, char **argv, bool &scaled);
 
 
 // Create template aliases that specify node evaluation.
@@ -57,21 +56,26 @@ using RBFSPriorityQueue = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>
 template <typename T, typename Comparator>
 using PriorityQueue = boost::heap::d_ary_heap<T, boost::heap::mutable_<true>, boost::heap::arity<2>, boost::heap::compare<Comparator>>;
 
+// States are vertex ids, so the closed list and frontier index need no hashing.
 template <typename T>
-using ClosedList = std::unordered_set<T>;
+using ClosedList = dense_set<T>;
 
 template <typename Traits>
 using Comparator = SimpleComparator<Traits, CostFunction>;
 
 template <typename Key, typename Value>
-using Map = std::unordered_map<Key, Value>;
+using Map = dense_map<Key, Value>;
 
-int main(int argc, char **argv)
+// Path costs as the real numbers they stand for.
+double real(cost_t const COST) { return COST; }
+double real(millionths::integer const COST) { return millionths::real(COST); }
+
+
+template <typename Traits, template <typename Traits_> class StepCost>
+void search(State const &INITIAL)
 {
-	init(argc, argv);
-	State const INITIAL(*boost::vertices(G).first);
-	Problem<Random, Distance, Neighbours, Visit, GoalTest> const PROBLEM(INITIAL);
-	
+	Problem<Traits, StepCost, OutEdges, EdgeTarget, GoalTest> const PROBLEM(INITIAL);
+
 	try
 	{
 		auto const T0(chrono::high_resolution_clock::now());
@@ -80,7 +84,7 @@ int main(int argc, char **argv)
 		auto const ELAPSED(chrono::high_resolution_clock::now() - T0);
 		cout.imbue(locale(""));
 		cout << "Done: " << std::chrono::duration_cast<std::chrono::microseconds>(ELAPSED).count() << " µs\n";
-		cout << backtrace(SOLUTION) << ": " << SOLUTION->path_cost() << "\n";
+		cout << backtrace(SOLUTION) << ": " << real(SOLUTION->path_cost()) << "\n";
 
 #ifdef STATISTICS
 		cerr << "**** STATISTICS ****\n";
@@ -88,22 +92,66 @@ int main(int argc, char **argv)
 		cerr << "popped: " << stats.popped << "\n";
 		cerr << "decreased: " << stats.decreased << "\n";
 		cerr << "discarded: " << stats.discarded << "\n";
+		cerr << "reopened: " << stats.reopened << "\n";
 #endif
 	}
 	catch (goal_not_found const &ex)
 	{
 		cout << "No path from " << INITIAL << " to the goal could be found!\n";
 	}
+	catch(cost_overflow const &EX)
+	{
+		cerr << EX.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+}
+
+
+int main(int argc, char **argv)
+{
+	bool scaled(false);
+	auto const INSTANCE(init(argc, argv, scaled));
+	context<random_instance> const CONTEXT(*INSTANCE);
+	State const INITIAL(0);
+
+	if(scaled)
+		search<ScaledRandom, ScaledWeight>(INITIAL);
+	else
+		search<Random, EdgeWeight>(INITIAL);
 }
 
 
-void init(int argc, char **argv)
+unique_ptr<random_instance> init(int argc, char **argv, bool &scaled)
 {
 	string const ARGV0(argv[0]);
-	unsigned b, n, s(chrono::high_resolution_clock::to_time_t(chrono::high_resolution_clock::now()));
+	string input, output;
+	unsigned expanded, b, n, s(chrono::high_resolution_clock::to_time_t(chrono::high_resolution_clock::now()));
 
 	// TODO: Use Program Options from Boost?
-	switch(argc)
+	for(;;)
+	{
+		if(argc > 1 && string(argv[1]) == "-i")
+		{
+			scaled = true;
+			argv += 1;
+			argc -= 1;
+		}
+		else if(argc > 2 && string(argv[1]) == "-o")
+		{
+			output = argv[2];
+			argv += 2;
+			argc -= 2;
+		}
+		else
+			break;
+	}
+
+	if(argc == 4 && string(argv[1]) == "-f")
+	{
+		input = argv[2];
+		istringstream(argv[3]) >> expanded;
+	}
+	else switch(argc)
 	{
 		case 5:
 			istringstream(argv[4]) >> s;
@@ -115,7 +163,10 @@ void init(int argc, char **argv)
 
 		case 1:
 		case 0:
-			cerr << "Invocation: " << ARGV0.substr(ARGV0.find_last_of('/') + 1) << " <(e)panded nodes> <(n)odes> <(b)ranching factor> [seed]\nSuch that: e < n and b < n and n > 2\n";
+			cerr << "Invocation: " << ARGV0.substr(ARGV0.find_last_of('/') + 1) << " [-i] [-o <graph file>] <(e)panded nodes> <(n)odes> <(b)ranching factor> [seed]\n"
+				"            " << ARGV0.substr(ARGV0.find_last_of('/') + 1) << " [-i] [-o <graph file>] -f <graph file> <(e)xpanded nodes>\n"
+				"Such that: e < n and b < n and n > 2\n"
+				"With -i, path costs are integer millionths.\n";
 			exit(EXIT_FAILURE);
 			break;
 			
@@ -125,18 +176,33 @@ void init(int argc, char **argv)
 			break;
 	}
 	
-	if(expanded > n)
+	try
 	{
-		cerr << "e(" << expanded << ") > n(" << n << ")\n";
+		auto const T0(chrono::steady_clock::now());
+		Graph graph(input.empty() ? gg::generate_csr_graph<cost_t>(n, b, mt19937(s)) : instance_file::read_graph<Graph>(input));
+		auto const ELAPSED(chrono::steady_clock::now() - T0);
+		cerr << (input.empty() ? "Generated" : "Loaded") << " in " << chrono::duration_cast<chrono::milliseconds>(ELAPSED).count() << " ms\n";
+
+		if(expanded > graph.num_vertices())
+		{
+			cerr << "e(" << expanded << ") > n(" << graph.num_vertices() << ")\n";
+			exit(EXIT_FAILURE);
+		}
+
+		if(!output.empty())
+			instance_file::write(output, graph);
+
+		return unique_ptr<random_instance>(new random_instance(move(graph), expanded));
+	}
+	catch(runtime_error const &EX)
+	{
+		cerr << EX.what() << "\n";
 		exit(EXIT_FAILURE);
 	}
-
-	G = Graph(n);
-	gg::generate_graph(G, boost::num_vertices(G), b, mt19937(s));
-	// weight = new WeightMap(get(boost::edge_weight, G));	
 }
 
 
+template <typename Node>
 string backtrace(Node const &NODE)
 {
 	return (NODE->parent() ? backtrace(NODE->parent()) + " => " : "") + to_string(NODE->state());
@@ -17,86 +17,43 @@
 */
 
 #include "problem.hpp"
+#include "graph.hpp"
+#include "csr_graph.hpp"
+#include "scaled_cost.hpp"
 
-#include <boost/graph/adjacency_matrix.hpp>
+#include <cstdint>
 
 using std::size_t;
-using boost::property;
-using boost::undirectedS;
-using boost::no_property;
-using boost::edge_weight_t;
 
 typedef double cost_t;
-typedef property<edge_weight_t, cost_t> edge_prop;
-typedef boost::adjacency_matrix<undirectedS, no_property, edge_prop> Graph;
-typedef boost::property_map<Graph, edge_weight_t>::type WeightMap;
-typedef typename boost::graph_traits<Graph>::edge_descriptor edge_desc;
-typedef typename boost::graph_traits<Graph>::vertex_descriptor vertex_desc;
+typedef csr_graph<cost_t> Graph;
 
-struct Random
+// One random graph problem: the graph, and how many goal tests fail before one succeeds.
+// The policies find it through jsearch::context<random_instance>.
+struct random_instance
 {
-	typedef vertex_desc state;
-	typedef edge_desc action;
-	typedef cost_t cost;
-	typedef cost_t pathcost;
-	typedef std::shared_ptr<jsearch::DefaultNode<Random>> node;
-	static bool const combinatorial = false;
-};
-
+	typedef Graph graph_type;
+	typedef Graph::weight_map weight_map;
 
-Graph G(0);
-WeightMap const weight = boost::get(boost::edge_weight, G);
-unsigned expanded = 0; // Expanded nodes.
+	random_instance(Graph &&GRAPH, unsigned const EXPANDED) : graph(std::move(GRAPH)), weight(graph.weights_map()), expanded(EXPANDED) {}
 
+	random_instance(random_instance const &) = delete;
+	random_instance &operator=(random_instance const &) = delete;
 
-template <typename Traits>
-class Distance
-{
-public:
-	typedef typename Traits::state State;
-	typedef typename Traits::action Action;
-	typedef typename Traits::pathcost PathCost;
-	
-protected:
-	PathCost step_cost(State const &, Action const &ACTION) const
-	{
-		return weight[ACTION];
-	}
+	Graph const graph;
+	weight_map const weight;
+	unsigned const expanded;
 };
 
 
-// ActionsPolicy returns neighbouring cities to STATE.
-template <typename Traits>
-class Neighbours
-{
-public:
-	typedef typename Traits::state State;
-	typedef typename Traits::action Action;
-	
-protected:
-	std::vector<Action> actions(State const &STATE) const
-	{
-		auto const IT(boost::out_edges(STATE, G));
-		return std::vector<Action>(IT.first, IT.second);
-	}
-};
+typedef jsearch::graph_search_traits<random_instance> Random;
 
+// The same graphs searched with path costs in millionths, which are exact and compare as integers.
+typedef jsearch::cost_scale<std::uint64_t, 1000000> millionths;
+typedef jsearch::graph_search_traits<random_instance, millionths::integer> ScaledRandom;
 
 template <typename Traits>
-class Visit
-{
-public:
-	typedef typename Traits::state State;
-	typedef typename Traits::action Action;
-	
-protected:
-	State result(State const &STATE, Action const &ACTION) const
-	{
-		auto const 	SOURCE(boost::source(ACTION, G)),
-					TARGET(boost::target(ACTION, G));
-		return SOURCE == STATE ? TARGET : SOURCE;
-	}
-};
+using ScaledWeight = jsearch::ScaledStepCost<Traits, jsearch::EdgeWeight, millionths>;
 
 
 template <typename Traits>
@@ -106,9 +63,14 @@ public:
 	typedef typename Traits::state State;
 	
 protected:
+	GoalTest() : tested(0) {}
+
+	// The count belongs to the problem, so each search of an instance starts again from zero.
 	bool goal_test(State const &) const
 	{
-		static size_t e_(0);
-		return e_++ == expanded;
+		return tested++ == jsearch::context<typename Traits::instance>::get().expanded;
 	}
+
+private:
+	mutable size_t tested;
 };
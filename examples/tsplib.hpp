@@ -0,0 +1,510 @@
+/*
+    tsplib.hpp: Load symmetric TSP instances in the TSPLIB format.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file tsplib.hpp
+ * @brief Loader for TYPE: TSP files with EXPLICIT, EUC_2D, CEIL_2D, ATT or GEO edge weights.
+ *
+ * The file is mapped into memory and parsed in place: keywords are compared
+ * where they lie and numbers are converted without copying them out, so the
+ * only allocations are the result's.  Distances follow the TSPLIB 95
+ * definitions, rounding included, so known optimal tour lengths apply.
+ */
+
+#ifndef TSPLIB_HPP
+#define TSPLIB_HPP
+
+#include "mapped_file.hpp"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace tsplib
+{
+	/** A symmetric instance: the cost between cities i and j is cost[i * dimension + j]. */
+	struct problem
+	{
+		std::string name;
+		std::size_t dimension;
+		std::vector<unsigned int> cost;
+	};
+
+
+	class parse_error : public std::runtime_error
+	{
+	public:
+		explicit parse_error(std::string const &WHAT) : std::runtime_error(WHAT) {}
+	};
+
+
+	namespace detail
+	{
+		enum class weight_type { NONE, EXPLICIT, EUC_2D, CEIL_2D, ATT, GEO };
+
+		// The orders of an EXPLICIT triangle.  The column-wise formats of a symmetric
+		// matrix list the same numbers as the row-wise format of the opposite triangle.
+		enum class weight_format { NONE, FUNCTION, FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW, LOWER_DIAG_ROW };
+
+
+		class cursor
+		{
+		public:
+			cursor(char const *FIRST, char const *LAST) : p(FIRST), last(LAST), line(1) {}
+
+			bool at_end() { skip_space(); return p == last; }
+
+			// Skip spaces and tabs but not the end of the line.
+			void skip_blank()
+			{
+				while(p != last && (*p == ' ' || *p == '\t' || *p == '\r'))
+					++p;
+			}
+
+			void skip_space()
+			{
+				for(; p != last && std::isspace(static_cast<unsigned char>(*p)); ++p)
+					if(*p == '\n')
+						++line;
+			}
+
+			void skip_line()
+			{
+				while(p != last && *p != '\n')
+					++p;
+			}
+
+			// A keyword, which ends at a space or a colon.
+			std::pair<char const *, char const *> keyword()
+			{
+				skip_space();
+				char const *const FIRST(p);
+				while(p != last && (std::isalnum(static_cast<unsigned char>(*p)) || *p == '_'))
+					++p;
+				if(p == FIRST)
+					fail("expected a keyword");
+				return std::make_pair(FIRST, p);
+			}
+
+			// The value of a "KEYWORD : value" line, without surrounding blanks.
+			std::pair<char const *, char const *> value()
+			{
+				skip_blank();
+				if(p != last && *p == ':')
+					++p;
+				skip_blank();
+				char const *const FIRST(p);
+				skip_line();
+				char const *end(p);
+				while(end != FIRST && std::isspace(static_cast<unsigned char>(end[-1])))
+					--end;
+				return std::make_pair(FIRST, end);
+			}
+
+			// Skip the colon that may follow a section keyword.
+			void section()
+			{
+				skip_blank();
+				if(p != last && *p == ':')
+					++p;
+			}
+
+			long integer()
+			{
+				skip_space();
+				bool const NEGATIVE(sign());
+				std::uint64_t magnitude(0);
+				char const *const FIRST(p);
+				for(; p != last && is_digit(*p); ++p)
+					magnitude = magnitude * 10 + (*p - '0');
+				if(p == FIRST)
+					fail("expected an integer");
+				return NEGATIVE ? -static_cast<long>(magnitude) : static_cast<long>(magnitude);
+			}
+
+			// A decimal number with an optional fraction and exponent.  The digits are
+			// accumulated exactly and scaled once by an exact power of ten, which rounds
+			// correctly for the up to 15 significant digits TSPLIB files use.
+			double real()
+			{
+				skip_space();
+				bool const NEGATIVE(sign());
+				std::uint64_t mantissa(0);
+				int exponent(0), digits(0);
+
+				for(; p != last && is_digit(*p); ++p, ++digits)
+					accumulate(mantissa, exponent, *p);
+				if(p != last && *p == '.')
+					for(++p; p != last && is_digit(*p); ++p, ++digits)
+					{
+						accumulate(mantissa, exponent, *p);
+						--exponent;
+					}
+				if(digits == 0)
+					fail("expected a number");
+
+				if(p != last && (*p == 'e' || *p == 'E'))
+				{
+					++p;
+					bool const NEGATIVE_EXPONENT(sign());
+					int e(0);
+					char const *const FIRST(p);
+					for(; p != last && is_digit(*p); ++p)
+						e = std::min(e * 10 + (*p - '0'), 1000);
+					if(p == FIRST)
+						fail("expected an exponent");
+					exponent += NEGATIVE_EXPONENT ? -e : e;
+				}
+
+				double const SCALE(std::pow(10.0, std::abs(exponent)));
+				double const VALUE(exponent < 0 ? mantissa / SCALE : mantissa * SCALE);
+				return NEGATIVE ? -VALUE : VALUE;
+			}
+
+			[[noreturn]] void fail(std::string const &WHAT) const
+			{
+				throw parse_error("line " + std::to_string(line) + ": " + WHAT);
+			}
+
+		private:
+			static bool is_digit(char const C) { return C >= '0' && C <= '9'; }
+
+			static void accumulate(std::uint64_t &mantissa, int &exponent, char const C)
+			{
+				if(mantissa < 100000000000000000ull)
+					mantissa = mantissa * 10 + (C - '0');
+				else
+					++exponent; // Beyond the precision of a double anyway.
+			}
+
+			bool sign()
+			{
+				if(p != last && (*p == '-' || *p == '+'))
+					return *p++ == '-';
+				return false;
+			}
+
+			char const *p;
+			char const *const last;
+			std::size_t line;
+		};
+
+
+		inline bool equals(std::pair<char const *, char const *> const &WORD, char const *LITERAL)
+		{
+			std::size_t const SIZE(WORD.second - WORD.first);
+			return SIZE == std::strlen(LITERAL) && std::memcmp(WORD.first, LITERAL, SIZE) == 0;
+		}
+
+
+		inline weight_type to_weight_type(cursor const &INPUT, std::pair<char const *, char const *> const &VALUE)
+		{
+			if(equals(VALUE, "EXPLICIT"))
+				return weight_type::EXPLICIT;
+			if(equals(VALUE, "EUC_2D"))
+				return weight_type::EUC_2D;
+			if(equals(VALUE, "CEIL_2D"))
+				return weight_type::CEIL_2D;
+			if(equals(VALUE, "ATT"))
+				return weight_type::ATT;
+			if(equals(VALUE, "GEO"))
+				return weight_type::GEO;
+			INPUT.fail("unsupported EDGE_WEIGHT_TYPE " + std::string(VALUE.first, VALUE.second));
+		}
+
+
+		inline weight_format to_weight_format(cursor const &INPUT, std::pair<char const *, char const *> const &VALUE)
+		{
+			if(equals(VALUE, "FUNCTION"))
+				return weight_format::FUNCTION;
+			if(equals(VALUE, "FULL_MATRIX"))
+				return weight_format::FULL_MATRIX;
+			if(equals(VALUE, "UPPER_ROW") || equals(VALUE, "LOWER_COL"))
+				return weight_format::UPPER_ROW;
+			if(equals(VALUE, "LOWER_ROW") || equals(VALUE, "UPPER_COL"))
+				return weight_format::LOWER_ROW;
+			if(equals(VALUE, "UPPER_DIAG_ROW") || equals(VALUE, "LOWER_DIAG_COL"))
+				return weight_format::UPPER_DIAG_ROW;
+			if(equals(VALUE, "LOWER_DIAG_ROW") || equals(VALUE, "UPPER_DIAG_COL"))
+				return weight_format::LOWER_DIAG_ROW;
+			INPUT.fail("unsupported EDGE_WEIGHT_FORMAT " + std::string(VALUE.first, VALUE.second));
+		}
+
+
+		inline void read_weights(cursor &input, weight_format const FORMAT, std::size_t const N, std::vector<unsigned int> &cost)
+		{
+			auto const READ([&](std::size_t const I, std::size_t const J)
+			{
+				long const W(input.integer());
+				if(W < 0)
+					input.fail("negative edge weight");
+				cost[I * N + J] = cost[J * N + I] = W;
+			});
+
+			switch(FORMAT)
+			{
+				case weight_format::FULL_MATRIX:
+					for(std::size_t i(0); i < N; ++i)
+						for(std::size_t j(0); j < N; ++j)
+						{
+							long const W(input.integer());
+							if(W < 0)
+								input.fail("negative edge weight");
+							cost[i * N + j] = W;
+						}
+					break;
+
+				case weight_format::UPPER_ROW:
+					for(std::size_t i(0); i < N; ++i)
+						for(std::size_t j(i + 1); j < N; ++j)
+							READ(i, j);
+					break;
+
+				case weight_format::LOWER_ROW:
+					for(std::size_t i(0); i < N; ++i)
+						for(std::size_t j(0); j < i; ++j)
+							READ(i, j);
+					break;
+
+				case weight_format::UPPER_DIAG_ROW:
+					for(std::size_t i(0); i < N; ++i)
+						for(std::size_t j(i); j < N; ++j)
+							READ(i, j);
+					break;
+
+				case weight_format::LOWER_DIAG_ROW:
+					for(std::size_t i(0); i < N; ++i)
+						for(std::size_t j(0); j <= i; ++j)
+							READ(i, j);
+					break;
+
+				default:
+					input.fail("EDGE_WEIGHT_SECTION needs an EDGE_WEIGHT_FORMAT");
+			}
+		}
+
+
+		// TSPLIB's nint().
+		inline unsigned int nint(double const X) { return static_cast<unsigned int>(X + 0.5); }
+
+
+		// The latitude or longitude in radians of a GEO coordinate in DDD.MM format.
+		inline double geo_radians(double const X)
+		{
+			double const PI(3.141592);
+			double const DEGREES(static_cast<int>(X));
+			return PI * (DEGREES + 5.0 * (X - DEGREES) / 3.0) / 180.0;
+		}
+
+
+		inline void compute_weights(weight_type const TYPE, std::vector<double> &x, std::vector<double> &y, std::vector<unsigned int> &cost)
+		{
+			std::size_t const N(x.size());
+
+			if(TYPE == weight_type::GEO)
+				for(std::size_t i(0); i < N; ++i)
+				{
+					x[i] = geo_radians(x[i]);
+					y[i] = geo_radians(y[i]);
+				}
+
+			for(std::size_t i(0); i < N; ++i)
+				for(std::size_t j(i + 1); j < N; ++j)
+				{
+					double const DX(x[i] - x[j]), DY(y[i] - y[j]);
+					unsigned int d(0);
+
+					switch(TYPE)
+					{
+						case weight_type::EUC_2D:
+							d = nint(std::sqrt(DX * DX + DY * DY));
+							break;
+
+						case weight_type::CEIL_2D:
+							d = static_cast<unsigned int>(std::ceil(std::sqrt(DX * DX + DY * DY)));
+							break;
+
+						case weight_type::ATT:
+						{
+							double const R(std::sqrt((DX * DX + DY * DY) / 10.0));
+							d = nint(R);
+							if(d < R)
+								++d;
+							break;
+						}
+
+						case weight_type::GEO:
+						{
+							double const RRR(6378.388);
+							double const Q1(std::cos(y[i] - y[j])), Q2(std::cos(x[i] - x[j])), Q3(std::cos(x[i] + x[j]));
+							d = static_cast<unsigned int>(RRR * std::acos(0.5 * ((1.0 + Q1) * Q2 - (1.0 - Q1) * Q3)) + 1.0);
+							break;
+						}
+
+						default:
+							break;
+					}
+
+					cost[i * N + j] = cost[j * N + i] = d;
+				}
+		}
+	}
+
+
+	/** Parse the TSPLIB text in [FIRST, LAST).  Throws parse_error. */
+	inline problem parse(char const *FIRST, char const *LAST)
+	{
+		using namespace detail;
+
+		cursor input(FIRST, LAST);
+		problem result;
+		result.dimension = 0;
+		weight_type type(weight_type::NONE);
+		weight_format format(weight_format::NONE);
+		std::vector<double> x, y;
+		bool weighted(false);
+
+		auto const DIMENSION([&]
+		{
+			if(result.dimension == 0)
+				input.fail("section before DIMENSION");
+			return result.dimension;
+		});
+
+		while(!input.at_end())
+		{
+			auto const KEY(input.keyword());
+
+			if(equals(KEY, "EOF"))
+				break;
+			else if(equals(KEY, "NAME"))
+			{
+				auto const VALUE(input.value());
+				result.name.assign(VALUE.first, VALUE.second);
+			}
+			else if(equals(KEY, "TYPE"))
+			{
+				auto const VALUE(input.value());
+				if(!equals(VALUE, "TSP"))
+					input.fail("unsupported TYPE " + std::string(VALUE.first, VALUE.second));
+			}
+			else if(equals(KEY, "DIMENSION"))
+			{
+				input.section();
+				long const N(input.integer());
+				if(N < 3)
+					input.fail("DIMENSION must be at least 3");
+				result.dimension = N;
+			}
+			else if(equals(KEY, "EDGE_WEIGHT_TYPE"))
+				type = to_weight_type(input, input.value());
+			else if(equals(KEY, "EDGE_WEIGHT_FORMAT"))
+				format = to_weight_format(input, input.value());
+			else if(equals(KEY, "COMMENT") || equals(KEY, "NODE_COORD_TYPE") || equals(KEY, "DISPLAY_DATA_TYPE") || equals(KEY, "EDGE_DATA_FORMAT"))
+				input.value();
+			else if(equals(KEY, "NODE_COORD_SECTION"))
+			{
+				input.section();
+				std::size_t const N(DIMENSION());
+				x.assign(N, 0.0);
+				y.assign(N, 0.0);
+				std::vector<bool> seen(N, false);
+				for(std::size_t k(0); k < N; ++k)
+				{
+					long const I(input.integer() - 1);
+					if(I < 0 || static_cast<std::size_t>(I) >= N || seen[I])
+						input.fail("bad node number");
+					seen[I] = true;
+					x[I] = input.real();
+					y[I] = input.real();
+				}
+			}
+			else if(equals(KEY, "EDGE_WEIGHT_SECTION"))
+			{
+				input.section();
+				std::size_t const N(DIMENSION());
+				result.cost.assign(N * N, 0);
+				read_weights(input, format, N, result.cost);
+				weighted = true;
+			}
+			else if(equals(KEY, "DISPLAY_DATA_SECTION"))
+			{
+				input.section();
+				for(std::size_t k(0), N(DIMENSION()); k < N; ++k)
+				{
+					input.integer();
+					input.real();
+					input.real();
+				}
+			}
+			else if(equals(KEY, "FIXED_EDGES_SECTION"))
+			{
+				input.section();
+				while(input.integer() != -1)
+					input.integer();
+			}
+			else
+				input.fail("unknown keyword " + std::string(KEY.first, KEY.second));
+		}
+
+		switch(type)
+		{
+			case weight_type::NONE:
+				input.fail("no EDGE_WEIGHT_TYPE");
+
+			case weight_type::EXPLICIT:
+				if(!weighted)
+					input.fail("EXPLICIT weights without an EDGE_WEIGHT_SECTION");
+				break;
+
+			default:
+				if(x.empty())
+					input.fail("coordinate weights without a NODE_COORD_SECTION");
+				result.cost.assign(result.dimension * result.dimension, 0);
+				compute_weights(type, x, y, result.cost);
+				break;
+		}
+
+		return result;
+	}
+
+
+	/** Load the TSPLIB file at PATH.  Throws std::runtime_error, or parse_error naming the file. */
+	inline problem load(std::string const &PATH)
+	{
+		jsearch::mapped_file const MAPPED(PATH);
+		try
+		{
+			return parse(MAPPED.begin(), MAPPED.end());
+		}
+		catch(parse_error const &EX)
+		{
+			throw parse_error(PATH + ": " + EX.what());
+		}
+	}
+}
+
+#endif // TSPLIB_HPP
@@ -0,0 +1,148 @@
+/*
+    graph.hpp: Policies that make a search problem of an explicit graph.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file graph.hpp
+ * @brief StepCost, Actions and Result policies for any Boost.Graph IncidenceGraph with an edge weight map.
+ *
+ * A state is a vertex descriptor and an action is an out-edge descriptor.  For
+ * graphs that store their vertices in a vector (adjacency_list<vecS, vecS>,
+ * compressed_sparse_row_graph, adjacency_matrix or a CSR of one's own) the
+ * states are therefore the dense integers 0 .. num_vertices - 1.  The actions
+ * of a state are the range of its out-edge iterators, never a copy.
+ *
+ * The policies find the graph and the weights in the instance named by the
+ * traits, through jsearch::context<typename Traits::instance>.  An instance
+ * needs the typedefs graph_type and weight_map and the members graph and
+ * weight; graph_instance is the simplest one.  The graph functions (out_edges,
+ * target, get) are called unqualified, so they are found by argument-dependent
+ * lookup for graphs and weight maps in any namespace.
+ *
+ *   typedef adjacency_list<vecS, vecS, undirectedS, no_property, property<edge_weight_t, unsigned>> Graph;
+ *   typedef graph_search_traits<graph_instance<Graph>> Traits;
+ *
+ *   graph_instance<Graph> const INSTANCE(g);
+ *   context<graph_instance<Graph>> const CONTEXT(INSTANCE);
+ *   Problem<Traits, EdgeWeight, OutEdges, EdgeTarget, GoalTest> const PROBLEM(source);
+ */
+
+#ifndef JSEARCH_GRAPH_HPP
+#define JSEARCH_GRAPH_HPP
+
+#include "problem.hpp"
+
+#include <memory>
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/range/iterator_range.hpp>
+
+
+namespace jsearch
+{
+	/** A graph that is searched where it is, with its weight map. */
+	template <typename Graph, typename WeightMap = typename boost::property_map<Graph, boost::edge_weight_t>::const_type>
+	struct graph_instance
+	{
+		typedef Graph graph_type;
+		typedef WeightMap weight_map;
+
+		explicit graph_instance(Graph const &GRAPH) : graph(GRAPH), weight(get(boost::edge_weight, GRAPH)) {}
+		graph_instance(Graph const &GRAPH, WeightMap const &WEIGHT) : graph(GRAPH), weight(WEIGHT) {}
+
+		Graph const &graph;
+		WeightMap const weight;
+	};
+
+
+	/**
+	 * Traits for searching the graph of Instance, with step and path costs the type of its
+	 * weights by default.  For another Cost, see ScaledStepCost in scaled_cost.hpp.
+	 */
+	template <typename Instance, typename Cost = typename boost::property_traits<typename Instance::weight_map>::value_type>
+	struct graph_search_traits
+	{
+		typedef Instance instance;
+		typedef typename boost::graph_traits<typename Instance::graph_type>::vertex_descriptor state;
+		typedef typename boost::graph_traits<typename Instance::graph_type>::edge_descriptor action;
+		typedef Cost cost;
+		typedef cost pathcost;
+		typedef std::shared_ptr<DefaultNode<graph_search_traits>> node;
+	};
+
+
+	template <typename Traits>
+	class OutEdges
+	{
+	public:
+		typedef typename Traits::state State;
+		typedef typename Traits::instance::graph_type Graph;
+		typedef boost::iterator_range<typename boost::graph_traits<Graph>::out_edge_iterator> Actions;
+
+	protected:
+		OutEdges() {}
+		~OutEdges() {}
+
+		Actions actions(State const &STATE) const
+		{
+			return boost::make_iterator_range(out_edges(STATE, context<typename Traits::instance>::get().graph));
+		}
+	};
+
+
+	// The weight itself, which is the path cost unless the traits say otherwise.
+	template <typename Traits>
+	class EdgeWeight
+	{
+	public:
+		typedef typename Traits::state State;
+		typedef typename Traits::action Action;
+		typedef typename boost::property_traits<typename Traits::instance::weight_map>::value_type Weight;
+
+	protected:
+		EdgeWeight() {}
+		~EdgeWeight() {}
+
+		Weight step_cost(State const &, Action const &ACTION) const
+		{
+			return get(context<typename Traits::instance>::get().weight, ACTION);
+		}
+	};
+
+
+	template <typename Traits>
+	class EdgeTarget
+	{
+	public:
+		typedef typename Traits::state State;
+		typedef typename Traits::action Action;
+
+	protected:
+		EdgeTarget() {}
+		~EdgeTarget() {}
+
+		// The out-edges of a vertex have it as their source, undirected graphs included.
+		State result(State const &, Action const &ACTION) const
+		{
+			return target(ACTION, context<typename Traits::instance>::get().graph);
+		}
+	};
+}
+
+#endif // JSEARCH_GRAPH_HPP
@@ -0,0 +1,127 @@
+/*
+    parallel_children.hpp: Make the children of one expansion across a thread pool.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file parallel_children.hpp
+ * @brief A ChildPolicy that makes the children of an expansion in parallel.
+ *
+ * Where making a child is expensive, typically because it carries a costly
+ * heuristic value (IncrementalChildPolicy), that work can be spread over the
+ * threads of a pool.  The engines still update the frontier and the closed
+ * list one child at a time, in the order of the actions, so the search
+ * expands exactly the same nodes as it would sequentially.
+ *
+ * The pool is that of the current context<child_threads>; without one, or
+ * with one thread, the children are made on the calling thread.  Each task
+ * runs with the caller's context<typename Traits::instance> and no other.
+ * A search running on a pool, as in a portfolio, has no child_threads unless
+ * it makes them, and must not use the pool it is running on.
+ *
+ *   template <typename Traits, template <typename> class StepCost, template <typename> class Result, template <typename> class Create>
+ *   using ParallelBoundedChild = ParallelChildPolicy<Traits, BoundedChild, StepCost, Result, Create>;
+ *
+ *   thread_pool pool;
+ *   child_threads const THREADS(pool);
+ *   context<child_threads> const CONTEXT(THREADS);
+ *   auto const SOLUTION(best_first_search<...>(PROBLEM));
+ */
+
+#ifndef JSEARCH_PARALLEL_CHILDREN_HPP
+#define JSEARCH_PARALLEL_CHILDREN_HPP
+
+#include "problem.hpp"
+#include "utils/context.hpp"
+#include "utils/thread_pool.hpp"
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+
+namespace jsearch
+{
+	/** The pool on which ParallelChildPolicy makes children, as the current context<child_threads>. */
+	struct child_threads
+	{
+		explicit child_threads(thread_pool &POOL) : pool(POOL) {}
+
+		thread_pool &pool;
+	};
+
+
+	/**
+	 * ChildPolicy, with the children of an expansion made in contiguous chunks, one per thread.
+	 *
+	 * ChildPolicy::child must be safe to call for different children at once: each
+	 * call may only write to its own child and to scratch state of its own.
+	 */
+	template <typename Traits,
+		template <typename Traits_,
+			template <typename Traits__> class StepCostPolicy_,
+			template <typename Traits__> class ResultPolicy_,
+			template <typename Traits__> class CreatePolicy_>
+			class ChildPolicy,
+		template <typename Traits_> class StepCostPolicy,
+		template <typename Traits_> class ResultPolicy,
+		template <typename Traits_> class CreatePolicy = DefaultNodeCreator>
+	class ParallelChildPolicy :	protected ChildPolicy<Traits, StepCostPolicy, ResultPolicy, CreatePolicy>,
+								protected detail::batches_children
+	{
+		typedef ChildPolicy<Traits, StepCostPolicy, ResultPolicy, CreatePolicy> Sequential;
+
+	protected:
+		using Sequential::child;
+
+		typedef typename Traits::node Node;
+		typedef typename Traits::state State;
+		typedef typename Traits::action Action;
+		typedef typename Traits::instance Instance;
+
+		ParallelChildPolicy() {}
+		~ParallelChildPolicy() {}
+
+		std::vector<Node> children(Node const &PARENT, std::vector<std::pair<Action, State>> const &STEPS) const
+		{
+			std::vector<Node> result(STEPS.size());
+			auto const THREADS(context<child_threads>::find());
+			std::size_t const CHUNKS(THREADS ? std::max<std::size_t>(1, std::min<std::size_t>(THREADS->pool.size(), STEPS.size())) : 1);
+
+			auto const CHUNK([&](std::size_t const I)
+			{
+				for(std::size_t i(STEPS.size() * I / CHUNKS); i != STEPS.size() * (I + 1) / CHUNKS; ++i)
+					result[i] = child(PARENT, STEPS[i].first, STEPS[i].second);
+			});
+
+			if(CHUNKS < 2)
+				CHUNK(0);
+			else
+			{
+				auto const &INSTANCE(context<Instance>::get());
+				THREADS->pool.run(CHUNKS, [&](std::size_t const I)
+				{
+					context<Instance> const SCOPE(INSTANCE);
+					CHUNK(I);
+				});
+			}
+			return result;
+		}
+	};
+}
+
+#endif // JSEARCH_PARALLEL_CHILDREN_HPP
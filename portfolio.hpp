@@ -0,0 +1,148 @@
+/*
+    portfolio.hpp: Race several searches of one problem and keep the first solution.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file portfolio.hpp
+ * @brief Run differently configured searches of a problem in parallel; the first to solve it wins.
+ *
+ * Which configuration is fastest varies from instance to instance and cannot
+ * be told in advance, but running them all at once and stopping when the
+ * first finishes takes about as long as the best of them would have alone
+ * (given a core each).  The losers are stopped through a shared cancellation.
+ *
+ * A search runs on a thread of the pool, where none of the caller's contexts
+ * are current, so it must make the contexts that its policies look up, and
+ * its own Problem if the policies have mutable state:
+ *
+ *   portfolio<TSP::node> race;
+ *   for(auto const &NAME : { "astar", "greedy", "ida" })
+ *       race.add(NAME, [&, NAME]
+ *       {
+ *           context<tsp_instance> const CONTEXT(INSTANCE);
+ *           TSPProblem const PROBLEM(INITIAL);
+ *           return SEARCHES(NAME, PROBLEM);
+ *       });
+ *
+ *   thread_pool pool(3);
+ *   auto const SOLUTION(race.run(pool));
+ *   std::cout << race.winner() << "\n";
+ */
+
+#ifndef JSEARCH_PORTFOLIO_HPP
+#define JSEARCH_PORTFOLIO_HPP
+
+#include "bestfirstsearch.hpp"
+#include "utils/cancellation.hpp"
+#include "utils/thread_pool.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <functional>
+
+
+namespace jsearch
+{
+	template <typename Result>
+	class portfolio
+	{
+	public:
+		typedef std::function<Result()> search_type;
+
+		portfolio &add(std::string const &NAME, search_type const &SEARCH)
+		{
+			searches.push_back(std::make_pair(NAME, SEARCH));
+			return *this;
+		}
+
+		/**
+		 * Run every search at once on POOL and return the first result that ACCEPT
+		 * accepts, cancelling the others.  A search whose result is not accepted
+		 * leaves the others running.  With fewer threads in POOL than searches,
+		 * the later searches start only as earlier ones finish.
+		 *
+		 * \throws goal_not_found if no search finds an acceptable result.
+		 * Any other exception from a search cancels the rest and is rethrown.
+		 */
+		template <typename Accept>
+		Result run(thread_pool &pool, Accept const &ACCEPT)
+		{
+			cancellation const CANCEL;
+			std::mutex mutex;
+			std::unique_ptr<Result> result;
+			std::size_t won(searches.size());
+
+			pool.run(searches.size(), [&](std::size_t const I)
+			{
+				if(CANCEL.cancelled())
+					return;
+
+				context<cancellation> const SCOPE(CANCEL);
+				try
+				{
+					auto candidate(searches[I].second());
+					if(ACCEPT(candidate))
+					{
+						std::lock_guard<std::mutex> const LOCK(mutex);
+						if(!result)
+						{
+							result.reset(new Result(std::move(candidate)));
+							won = I;
+							CANCEL.cancel();
+						}
+					}
+				}
+				catch(search_cancelled const &)
+				{
+				}
+				catch(goal_not_found const &)
+				{
+				}
+				catch(...)
+				{
+					CANCEL.cancel();
+					throw;
+				}
+			});
+
+			if(!result)
+				throw goal_not_found();
+			winner_ = searches[won].first;
+			return std::move(*result);
+		}
+
+		/** Run every search at once on POOL and return the first result. */
+		Result run(thread_pool &pool)
+		{
+			return run(pool, [](Result const &){ return true; });
+		}
+
+		/** The name of the search that won the last run. */
+		std::string const &winner() const { return winner_; }
+
+		std::size_t size() const { return searches.size(); }
+
+	private:
+		std::vector<std::pair<std::string, search_type>> searches;
+		std::string winner_;
+	};
+}
+
+#endif // JSEARCH_PORTFOLIO_HPP
@@ -31,7 +31,11 @@
 #include "to_string.hpp"
 #endif
 
+#include "utils/context.hpp"
+
 #include <memory>
+#include <vector>
+#include <type_traits>
 
 
 namespace jsearch
@@ -52,6 +56,11 @@ namespace jsearch
 		{
             return std::make_shared<typename Node::element_type>(STATE, PARENT, ACTION, PATHCOST);
 		}
+
+		Node create(State const &STATE, Node const &PARENT, Action const &ACTION, PathCost const &PATHCOST, PathCost const &H) const
+		{
+			return std::make_shared<typename Node::element_type>(STATE, PARENT, ACTION, PATHCOST, H);
+		}
 	};
 
 
@@ -71,6 +80,43 @@ namespace jsearch
 		{
 			return std::make_shared<typename Node::element_type>(STATE, ACTION, PATHCOST);
 		}
+
+		Node create(State const &STATE, Node const &, Action const &ACTION, PathCost const &PATHCOST, PathCost const &H) const
+		{
+			return std::make_shared<typename Node::element_type>(STATE, ACTION, PATHCOST, H);
+		}
+	};
+
+
+	/**
+	 * DefaultNodeCreator with the memory for each node (and its reference count) from Allocator,
+	 * e.g. a tracking_allocator.  Use it in a Problem through an alias that fixes the allocator:
+	 *
+	 *   template <typename Traits>
+	 *   using TrackedNodes = AllocatingNodeCreator<Traits, tracking_allocator<void, component::NODES>>;
+	 */
+	template <typename Traits, typename Allocator>
+	class AllocatingNodeCreator
+	{
+	protected:
+		typedef typename Traits::node Node;
+		typedef typename Traits::state State;
+		typedef typename Traits::action Action;
+		typedef typename Traits::pathcost PathCost;
+		typedef typename std::allocator_traits<Allocator>::template rebind_alloc<typename Node::element_type> NodeAllocator;
+
+		AllocatingNodeCreator() {}
+		~AllocatingNodeCreator() {}
+
+		Node create(State const &STATE, Node const &PARENT, Action const &ACTION, PathCost const &PATHCOST) const
+		{
+			return std::allocate_shared<typename Node::element_type>(NodeAllocator(), STATE, PARENT, ACTION, PATHCOST);
+		}
+
+		Node create(State const &STATE, Node const &PARENT, Action const &ACTION, PathCost const &PATHCOST, PathCost const &H) const
+		{
+			return std::allocate_shared<typename Node::element_type>(NodeAllocator(), STATE, PARENT, ACTION, PATHCOST, H);
+		}
 	};
 
 
@@ -144,21 +190,71 @@ namespace jsearch
 		return stream;
 	}
 #endif
+
+
+	/**
+	 * A node that carries its value of HeuristicPolicy, computed once when it is made by
+	 * IncrementalChildPolicy.  The evaluation policies use the carried value instead of
+	 * calling HeuristicPolicy again, but only if their HeuristicPolicy is the same one.
+	 * The initial node is made without a value and has_h() is false.
+	 */
+	template <typename Traits, template <typename Traits_> class HeuristicPolicy>
+	class HeuristicNode : public DefaultNode<Traits>
+	{
+	public:
+		typedef HeuristicPolicy<Traits> heuristic;
+		typedef typename Traits::node Node;
+		typedef typename Traits::state State;
+		typedef typename Traits::action Action;
+		typedef typename Traits::pathcost PathCost;
+
+		HeuristicNode(State const &STATE, Node const &PARENT, Action const &ACTION, PathCost const &PATH_COST) : DefaultNode<Traits>(STATE, PARENT, ACTION, PATH_COST), h_(), has_h_(false) {}
+		HeuristicNode(State const &STATE, Node const &PARENT, Action const &ACTION, PathCost const &PATH_COST, PathCost const &H) : DefaultNode<Traits>(STATE, PARENT, ACTION, PATH_COST), h_(H), has_h_(true) {}
+
+		bool has_h() const { return has_h_; }
+		PathCost const &h() const { return h_; }
+
+	private:
+		PathCost h_;
+		bool has_h_;
+	};
+
+
+	/** The ComboNode counterpart of HeuristicNode. */
+	template <typename Traits, template <typename Traits_> class HeuristicPolicy>
+	class HeuristicComboNode : public ComboNode<Traits>
+	{
+	public:
+		typedef HeuristicPolicy<Traits> heuristic;
+		typedef typename Traits::state State;
+		typedef typename Traits::action Action;
+		typedef typename Traits::pathcost PathCost;
+
+		HeuristicComboNode(State const &STATE, Action const &ACTION, PathCost const &PATH_COST) : ComboNode<Traits>(STATE, ACTION, PATH_COST), h_(), has_h_(false) {}
+		HeuristicComboNode(State const &STATE, Action const &ACTION, PathCost const &PATH_COST, PathCost const &H) : ComboNode<Traits>(STATE, ACTION, PATH_COST), h_(H), has_h_(true) {}
+
+		bool has_h() const { return has_h_; }
+		PathCost const &h() const { return h_; }
+
+	private:
+		PathCost h_;
+		bool has_h_;
+	};
 	
 
 	template <typename Traits,
 		template <typename Traits_> class StepCostPolicy,
 		template <typename Traits_> class ResultPolicy,
 		template <typename Traits_> class CreatePolicy = DefaultNodeCreator>
-	class DefaultChildPolicy :	protected virtual StepCostPolicy<Traits>,
-								protected virtual ResultPolicy<Traits>,
-								protected virtual CreatePolicy<Traits>
+	class DefaultChildPolicy :	protected StepCostPolicy<Traits>,
+								protected ResultPolicy<Traits>,
+								protected CreatePolicy<Traits>
 	{
+	protected:
 		using StepCostPolicy<Traits>::step_cost;
 		using ResultPolicy<Traits>::result;
 		using CreatePolicy<Traits>::create;
 
-	protected:
 		typedef typename Traits::node Node;
 		typedef typename Traits::state State;
 		typedef typename Traits::action Action;
@@ -179,6 +275,99 @@ namespace jsearch
 	};
 
 
+	/**
+	 * Make children that carry their heuristic value (see HeuristicNode and HeuristicComboNode).
+	 *
+	 * If HeuristicPolicy has the incremental form
+	 *
+	 *   PathCost h(PathCost const &PARENT_H, State const &PARENT, Action const &ACTION, State const &CHILD) const;
+	 *
+	 * then the child's h is computed from its parent's, otherwise by h(CHILD).
+	 * Use it in a Problem through an alias that fixes the heuristic:
+	 *
+	 *   template <typename Traits, template <typename> class StepCost, template <typename> class Result, template <typename> class Create>
+	 *   using ManhattanChild = IncrementalChildPolicy<Traits, Manhattan, StepCost, Result, Create>;
+	 */
+	template <typename Traits,
+		template <typename Traits_> class HeuristicPolicy,
+		template <typename Traits_> class StepCostPolicy,
+		template <typename Traits_> class ResultPolicy,
+		template <typename Traits_> class CreatePolicy = DefaultNodeCreator>
+	class IncrementalChildPolicy :	protected HeuristicPolicy<Traits>,
+									protected StepCostPolicy<Traits>,
+									protected ResultPolicy<Traits>,
+									protected CreatePolicy<Traits>
+	{
+		using HeuristicPolicy<Traits>::h;
+
+	protected:
+		using StepCostPolicy<Traits>::step_cost;
+		using ResultPolicy<Traits>::result;
+		using CreatePolicy<Traits>::create;
+
+		typedef typename Traits::node Node;
+		typedef typename Traits::state State;
+		typedef typename Traits::action Action;
+		typedef typename Traits::pathcost PathCost;
+
+		IncrementalChildPolicy() {}
+		~IncrementalChildPolicy() {}
+
+		Node child(Node const &PARENT, Action const &ACTION) const
+		{
+			return child(PARENT, ACTION, result(PARENT->state(), ACTION));
+		}
+
+		Node child(Node const &PARENT, Action const &ACTION, State const &STATE) const
+		{
+			return create(STATE, PARENT, ACTION, PARENT->path_cost() + step_cost(PARENT->state(), ACTION), child_h(PARENT, ACTION, STATE, 0));
+		}
+
+	private:
+		template <typename Node_>
+		auto child_h(Node_ const &PARENT, Action const &ACTION, State const &STATE, int) const -> decltype(this->h(PARENT->h(), PARENT->state(), ACTION, STATE))
+		{
+			return h(PARENT->has_h() ? PARENT->h() : h(PARENT->state()), PARENT->state(), ACTION, STATE);
+		}
+
+		template <typename Node_>
+		PathCost child_h(Node_ const &, Action const &, State const &STATE, long) const
+		{
+			return h(STATE);
+		}
+	};
+
+
+	namespace detail
+	{
+		// Stands in for a policy that the host already has through another base.
+		template <typename Policy>
+		struct inherited {};
+
+		/** Policy, or an empty stand-in for it if Host already derives from it. */
+		template <typename Host, typename Policy>
+		using unless_base_of = typename std::conditional<std::is_base_of<Policy, Host>::value, inherited<Policy>, Policy>::type;
+
+		/**
+		 * The base of a ChildPolicy that makes all the children of an expansion at once:
+		 *
+		 *   std::vector<Node> children(Node const &PARENT, std::vector<std::pair<Action, State>> const &STEPS) const;
+		 *
+		 * The engines give it every admitted action and its successor, in order, and
+		 * expect the children in the same order.  See ParallelChildPolicy.
+		 */
+		struct batches_children {};
+	}
+
+
+	/**
+	 * The problem: its initial state and the policies that make up its state model.
+	 *
+	 * Each policy is inherited exactly once and not virtually, so the policies are
+	 * empty bases that take no space and their calls are resolved statically.  The
+	 * ChildPolicy usually brings the step-cost, result and create policies with it;
+	 * they are inherited directly only when it does not.
+	 */
 	template <typename Traits,
 			 template <typename Traits_> class StepCostPolicy,
 			 template <typename Traits_> class ActionsPolicy,
@@ -188,15 +377,15 @@ namespace jsearch
 			 template <typename Traits_,
 				template <typename Traits__> class StepCostPolicy_,
 				template <typename Traits__> class ResultPolicy_,
-				template <typename Traits__> class CreatePolicy>
+				template <typename Traits__> class CreatePolicy_>
 				class ChildPolicy = DefaultChildPolicy>
 	struct Problem :
-		protected virtual StepCostPolicy<Traits>,
-		protected virtual ActionsPolicy<Traits>,
-		protected virtual ResultPolicy<Traits>,
-		protected virtual GoalTestPolicy<Traits>,
-		protected virtual ChildPolicy<Traits, StepCostPolicy, ResultPolicy, CreatePolicy>,
-		protected virtual CreatePolicy<Traits>
+		protected ChildPolicy<Traits, StepCostPolicy, ResultPolicy, CreatePolicy>,
+		protected detail::unless_base_of<ChildPolicy<Traits, StepCostPolicy, ResultPolicy, CreatePolicy>, StepCostPolicy<Traits>>,
+		protected detail::unless_base_of<ChildPolicy<Traits, StepCostPolicy, ResultPolicy, CreatePolicy>, ResultPolicy<Traits>>,
+		protected detail::unless_base_of<ChildPolicy<Traits, StepCostPolicy, ResultPolicy, CreatePolicy>, CreatePolicy<Traits>>,
+		protected ActionsPolicy<Traits>,
+		protected GoalTestPolicy<Traits>
 	{
 		typedef typename Traits::node Node;
 		typedef typename Traits::state State;
@@ -212,6 +401,13 @@ namespace jsearch
 		using GoalTestPolicy<Traits>::goal_test;
 		using CreatePolicy<Traits>::create;
 
+		/** Only for a ChildPolicy derived from detail::batches_children. */
+		template <typename Steps>
+		std::vector<Node> children(Node const &PARENT, Steps const &STEPS) const
+		{
+			return ChildPolicy<Traits, StepCostPolicy, ResultPolicy, CreatePolicy>::children(PARENT, STEPS);
+		}
+
         State const initial;
 	};
 }
@@ -0,0 +1,115 @@
+/*
+    registry.hpp: Choose a search configuration by name at run time.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file registry.hpp
+ * @brief A table of fully instantiated searches, chosen by name at run time.
+ *
+ * The engine, cost function, tie-breaking and queue of a search are template
+ * parameters, so that its inner loop is compiled for exactly that combination.
+ * A search_registry holds a set of such instantiations, compiled in advance,
+ * under names, and calls the one named at run time.  The choice costs one
+ * lookup and one indirect call per search; nothing changes inside the search.
+ *
+ * The entries all have the Signature of the registry.  Each is usually a
+ * lambda that names the combination, which converts to a function pointer
+ * because it captures nothing:
+ *
+ *   typedef Problem<TSP, EdgeCost, HigherCostValidEdges, AppendEdge, ValidTour> TSPProblem;
+ *
+ *   search_registry<TSP::node(TSPProblem const &)> searches;
+ *   searches.add("astar", [](TSPProblem const &P) { return best_first_search<PriorityQueue, Comparator>(P); })
+ *           .add("rbfs", [](TSPProblem const &P) { return recursive_best_first_search<CostFunction, FalseTiePolicy, RBFSPriorityQueue>(P); });
+ *
+ *   auto const SOLUTION(searches(NAME, PROBLEM));
+ */
+
+#ifndef JSEARCH_REGISTRY_HPP
+#define JSEARCH_REGISTRY_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+
+namespace jsearch
+{
+	class unknown_configuration : public std::invalid_argument
+	{
+	public:
+		explicit unknown_configuration(std::string const &NAME) : std::invalid_argument("unknown search configuration: " + NAME) {}
+	};
+
+
+	template <typename Signature>
+	class search_registry;
+
+
+	template <typename Result, typename... Args>
+	class search_registry<Result(Args...)>
+	{
+	public:
+		typedef Result (*search_type)(Args...);
+
+		/** Register SEARCH as NAME.  Throws std::invalid_argument if NAME is taken. */
+		search_registry &add(std::string const &NAME, search_type const SEARCH)
+		{
+			if(!searches.insert(std::make_pair(NAME, SEARCH)).second)
+				throw std::invalid_argument("search configuration registered twice: " + NAME);
+			return *this;
+		}
+
+		/** The search called NAME, or nullptr if there is none. */
+		search_type find(std::string const &NAME) const
+		{
+			auto const IT(searches.find(NAME));
+			return IT == std::end(searches) ? nullptr : IT->second;
+		}
+
+		/** The search called NAME.  Throws unknown_configuration if there is none. */
+		search_type get(std::string const &NAME) const
+		{
+			auto const SEARCH(find(NAME));
+			if(!SEARCH)
+				throw unknown_configuration(NAME);
+			return SEARCH;
+		}
+
+		/** Run the search called NAME. */
+		Result operator()(std::string const &NAME, Args... args) const
+		{
+			return get(NAME)(std::forward<Args>(args)...);
+		}
+
+		/** The names of all the searches, in order. */
+		std::vector<std::string> names() const
+		{
+			std::vector<std::string> result;
+			for(auto const &S : searches)
+				result.push_back(S.first);
+			return result;
+		}
+
+	private:
+		std::map<std::string, search_type> searches;
+	};
+}
+
+#endif // JSEARCH_REGISTRY_HPP
@@ -0,0 +1,132 @@
+/*
+    scaled_cost.hpp: Integer path costs for domains with floating-point step costs.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file scaled_cost.hpp
+ * @brief A StepCost policy that rounds floating-point step costs to fixed-point integers.
+ *
+ * A cost_scale counts costs in integer multiples of 1/Scale.  ScaledStepCost
+ * rounds each step cost to the nearest multiple as the child is generated, so
+ * path costs are sums of integers: they add and compare exactly, ties are real
+ * ties, and they can key an integer priority queue.  cost_scale::real converts
+ * a path cost back for reporting.  A search is then optimal with respect to the
+ * rounded step costs, which differ from the real ones by at most 1/(2 Scale).
+ *
+ * The traits name the integer as their cost and pathcost; for a graph:
+ *
+ *   typedef cost_scale<std::uint64_t, 1000000> millionths;
+ *   typedef graph_search_traits<Instance, millionths::integer> Traits;
+ *
+ *   template <typename Traits>
+ *   using ScaledWeight = ScaledStepCost<Traits, EdgeWeight, millionths>;
+ *
+ *   Problem<Traits, ScaledWeight, OutEdges, EdgeTarget, GoalTest> const PROBLEM(source);
+ */
+
+#ifndef JSEARCH_SCALED_COST_HPP
+#define JSEARCH_SCALED_COST_HPP
+
+#include <limits>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace jsearch
+{
+	class cost_overflow : public std::overflow_error
+	{
+	public:
+		explicit cost_overflow(std::string const &WHAT) : std::overflow_error(WHAT) {}
+	};
+
+
+	/**
+	 * Costs held in Integer as multiples of 1/Scale.
+	 *
+	 * A step may cost at most MAX_STEP, a MaxLength'th of what Integer can hold,
+	 * so that no path of up to MaxLength steps overflows.
+	 */
+	template <typename Integer, std::uintmax_t Scale, std::uintmax_t MaxLength = std::uintmax_t(1) << 16>
+	struct cost_scale
+	{
+		static_assert(std::is_integral<Integer>::value, "cost_scale: Integer is not an integer type.");
+		static_assert(Scale > 0 && Scale <= std::uintmax_t(std::numeric_limits<Integer>::max()), "cost_scale: Integer cannot hold Scale.");
+		static_assert(MaxLength > 0 && std::uintmax_t(std::numeric_limits<Integer>::max()) / MaxLength >= Scale, "cost_scale: Integer cannot hold MaxLength steps of cost 1.");
+
+		typedef Integer integer;
+
+		static constexpr Integer SCALE = Scale;
+		static constexpr Integer MAX_STEP = std::numeric_limits<Integer>::max() / MaxLength;
+
+		/** COST to the nearest multiple of 1/Scale.  Throws cost_overflow if it is negative, not a number or more than MAX_STEP. */
+		template <typename Real>
+		static Integer scaled(Real const COST)
+		{
+			static_assert(std::is_floating_point<Real>::value, "cost_scale: Real is not a floating-point type.");
+			Real const RESULT(COST * Real(Scale) + Real(0.5));
+			if(!(COST >= 0 && RESULT < Real(MAX_STEP) + 1))
+				throw cost_overflow("cost_scale: step cost " + std::to_string(COST) + " is out of range.");
+			return static_cast<Integer>(RESULT);
+		}
+
+		/** The real value of COST. */
+		template <typename Real = double>
+		static Real real(Integer const COST)
+		{
+			return static_cast<Real>(COST) / Real(Scale);
+		}
+	};
+
+	template <typename Integer, std::uintmax_t Scale, std::uintmax_t MaxLength>
+	constexpr Integer cost_scale<Integer, Scale, MaxLength>::SCALE;
+
+	template <typename Integer, std::uintmax_t Scale, std::uintmax_t MaxLength>
+	constexpr Integer cost_scale<Integer, Scale, MaxLength>::MAX_STEP;
+
+
+	/**
+	 * The step costs of StepCostPolicy, scaled to the integer pathcost of Traits.
+	 *
+	 * StepCostPolicy must return the domain's own floating-point cost (EdgeWeight
+	 * returns the type of the weights) rather than Traits::pathcost.  Use it in a
+	 * Problem through an alias that fixes the policy and the scale.
+	 */
+	template <typename Traits, template <typename Traits_> class StepCostPolicy, typename Scale>
+	class ScaledStepCost : protected StepCostPolicy<Traits>
+	{
+	public:
+		typedef typename Traits::state State;
+		typedef typename Traits::action Action;
+		typedef typename Traits::pathcost PathCost;
+
+		static_assert(std::is_same<PathCost, typename Scale::integer>::value, "ScaledStepCost: the path cost is not the integer of the scale.");
+
+	protected:
+		ScaledStepCost() {}
+		~ScaledStepCost() {}
+
+		PathCost step_cost(State const &STATE, Action const &ACTION) const
+		{
+			return Scale::scaled(StepCostPolicy<Traits>::step_cost(STATE, ACTION));
+		}
+	};
+}
+
+#endif // JSEARCH_SCALED_COST_HPP
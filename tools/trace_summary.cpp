@@ -0,0 +1,228 @@
+/*
+    trace_summary.cpp: Summarize a search trace written by trace_recorder.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * trace_summary <trace file> [search]
+ *
+ * One line for each search in the trace (they begin at each START event),
+ * then for one search, by default the one with the most expansions:
+ *  - expansions per f-layer, with f as the search's cost function has it;
+ *  - the size of the frontier as the search goes on;
+ *  - the branching factor, as children per expansion (including those thrown
+ *    away as duplicates or closed) and as new frontier nodes per expansion.
+ */
+
+#include "trace.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+using namespace std;
+using namespace jsearch;
+
+
+struct search_summary
+{
+	search_summary() : first(0), last(0), expanded(0), generated(0), duplicates(0), decreases(0), closed(0), frontier(0), peak(0) {}
+
+	size_t first, last; // The records of this search are [first, last).
+	size_t expanded, generated, duplicates, decreases, closed;
+	long frontier, peak;
+};
+
+
+vector<search_summary> split(vector<trace_record> const &TRACE)
+{
+	vector<search_summary> result;
+	for(size_t i(0); i != TRACE.size(); ++i)
+	{
+		auto const &R(TRACE[i]);
+		if(R.event == trace_event::START || result.empty())
+		{
+			if(!result.empty())
+				result.back().last = i;
+			result.emplace_back();
+			result.back().first = i;
+		}
+
+		auto &s(result.back());
+		switch(R.event)
+		{
+			case trace_event::START:
+			case trace_event::GENERATE:
+				++s.generated;
+				++s.frontier;
+				break;
+			case trace_event::EXPAND:
+				++s.expanded;
+				--s.frontier;
+				break;
+			case trace_event::DUPLICATE:
+				++s.duplicates;
+				break;
+			case trace_event::DECREASE:
+				++s.decreases;
+				break;
+			case trace_event::CLOSED:
+				++s.closed;
+				break;
+		}
+		s.peak = max(s.peak, s.frontier);
+	}
+	if(!result.empty())
+		result.back().last = TRACE.size();
+	return result;
+}
+
+
+double milliseconds(vector<trace_record> const &TRACE, size_t const FIRST, size_t const I)
+{
+	return (TRACE[I].nanoseconds - TRACE[FIRST].nanoseconds) / 1e6;
+}
+
+
+void f_layers(vector<trace_record> const &TRACE, search_summary const &S)
+{
+	map<double, size_t> layers;
+	size_t unknown(0);
+	for(size_t i(S.first); i != S.last; ++i)
+		if(TRACE[i].event == trace_event::EXPAND)
+		{
+			if(isnan(TRACE[i].f))
+				++unknown;
+			else
+				++layers[TRACE[i].f];
+		}
+
+	// Continuous costs make a layer of nearly every node, so group them into at most MAX_ROWS ranges.
+	size_t const MAX_ROWS(40);
+	cout << "\nexpansions per f-layer:\n";
+	if(unknown)
+		cout << unknown << " expansions without f: the comparator has no known cost function.\n";
+	if(layers.empty())
+		return;
+	cout << setw(16) << "f" << setw(14) << "expanded" << setw(12) << "cumulative\n";
+	double const LOW(layers.begin()->first), WIDTH((layers.rbegin()->first - LOW) / MAX_ROWS);
+	size_t cumulative(0);
+	for(auto it(layers.begin()); it != layers.end(); )
+	{
+		double const F(it->first);
+		size_t count(0);
+		if(layers.size() <= MAX_ROWS)
+			count = (it++)->second;
+		else
+		{
+			// Bin by an integer index so that every layer lands in exactly one range, whatever the rounding.
+			auto const BIN([&](double const X) { return min(MAX_ROWS - 1, size_t((X - LOW) / WIDTH)); });
+			size_t const B(BIN(F));
+			do
+				count += (it++)->second;
+			while(it != layers.end() && BIN(it->first) == B);
+		}
+		cumulative += count;
+		cout << setw(layers.size() <= MAX_ROWS ? 16 : 14) << F << (layers.size() <= MAX_ROWS ? "" : " +") << setw(14) << count << setw(10) << fixed << setprecision(1) << 100.0 * cumulative / S.expanded << " %\n";
+		cout.unsetf(ios::floatfield);
+		cout << setprecision(6);
+	}
+}
+
+
+void frontier_growth(vector<trace_record> const &TRACE, search_summary const &S)
+{
+	size_t const POINTS(20);
+	cout << "\nfrontier growth:\n" << setw(14) << "expanded" << setw(14) << "frontier" << setw(12) << "ms\n";
+	size_t expanded(0), next(1);
+	long frontier(0);
+	for(size_t i(S.first); i != S.last; ++i)
+	{
+		auto const EVENT(TRACE[i].event);
+		frontier += EVENT == trace_event::START || EVENT == trace_event::GENERATE;
+		if(EVENT == trace_event::EXPAND)
+		{
+			--frontier;
+			if(++expanded == max<size_t>(1, S.expanded * next / POINTS))
+			{
+				cout << setw(14) << expanded << setw(14) << frontier << setw(12) << fixed << setprecision(1) << milliseconds(TRACE, S.first, i) << "\n";
+				cout.unsetf(ios::floatfield);
+				while(next <= POINTS && max<size_t>(1, S.expanded * next / POINTS) <= expanded)
+					++next;
+			}
+		}
+	}
+}
+
+
+int main(int argc, char **argv)
+{
+	if(argc != 2 && argc != 3)
+	{
+		cerr << "Invocation: trace_summary <trace file> [search]\n";
+		exit(EXIT_FAILURE);
+	}
+
+	try
+	{
+		auto const TRACE(read_trace(argv[1]));
+		auto const SEARCHES(split(TRACE));
+		if(SEARCHES.empty())
+		{
+			cout << argv[1] << ": no events.\n";
+			return EXIT_SUCCESS;
+		}
+
+		cout << TRACE.size() << " events in " << SEARCHES.size() << " search" << (SEARCHES.size() == 1 ? "" : "es") << "\n";
+		cout << setw(6) << "search" << setw(12) << "expanded" << setw(12) << "generated" << setw(12) << "duplicate" << setw(12) << "decrease" << setw(12) << "closed" << setw(12) << "peak" << setw(12) << "ms\n";
+		size_t largest(0);
+		for(size_t i(0); i != SEARCHES.size(); ++i)
+		{
+			auto const &S(SEARCHES[i]);
+			cout << setw(6) << i << setw(12) << S.expanded << setw(12) << S.generated << setw(12) << S.duplicates << setw(12) << S.decreases << setw(12) << S.closed << setw(12) << S.peak << setw(11) << fixed << setprecision(1) << milliseconds(TRACE, S.first, S.last - 1) << "\n";
+			cout.unsetf(ios::floatfield);
+			if(S.expanded > SEARCHES[largest].expanded)
+				largest = i;
+		}
+
+		size_t chosen(largest);
+		if(argc == 3 && (!(istringstream(argv[2]) >> chosen) || chosen >= SEARCHES.size()))
+			throw runtime_error(string(argv[2]) + ": no such search.");
+
+		auto const &S(SEARCHES[chosen]);
+		cout << "\nsearch " << chosen << ":\n";
+		if(S.expanded)
+		{
+			cout << "children per expansion: " << fixed << setprecision(3) << double(S.generated - 1 + S.duplicates + S.decreases + S.closed) / S.expanded << "\n";
+			cout << "new frontier nodes per expansion: " << double(S.generated - 1) / S.expanded << "\n";
+			cout.unsetf(ios::floatfield);
+			cout << setprecision(6);
+		}
+		f_layers(TRACE, S);
+		frontier_growth(TRACE, S);
+	}
+	catch(runtime_error const &EX)
+	{
+		cerr << EX.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+}
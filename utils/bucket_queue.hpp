@@ -0,0 +1,296 @@
+#ifndef JSEARCH_BUCKET_QUEUE_HPP
+#define JSEARCH_BUCKET_QUEUE_HPP 1
+
+/*
+    bucket_queue.hpp: A frontier of buckets by f and then by h, for integer costs.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * NOTE: This header was not designed to be included manually.  It will be
+ * included automatically by the main search header.
+ */
+
+#include "queue_set.hpp"
+#include "../evaluation.hpp"
+
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+#include <cassert>
+
+
+namespace jsearch
+{
+	/**
+	 * Selector for the bucketed frontier.
+	 *
+	 * Like indexed_d_ary_heap it is never defined, only named in the PriorityQueue
+	 * template alias given to best_first_search:
+	 *
+	 *   template <typename T, typename Comparator>
+	 *   using PriorityQueue = jsearch::bucket_queue<T, Comparator>;
+	 *
+	 * which selects the queue_set specialization below for a TiebreakingComparator
+	 * whose TiePolicy is LowH or FalseTiePolicy, or for a SimpleComparator.
+	 */
+	template <typename T, typename Comparator>
+	struct bucket_queue;
+
+
+	namespace detail
+	{
+		/** The heuristic by which TiePolicy breaks ties, which is what the buckets within an f-bucket are for. */
+		template <typename TiePolicy>
+		struct tie_heuristic
+		{
+			static_assert(sizeof(TiePolicy) == 0, "bucket_queue: the TiePolicy must be LowH or FalseTiePolicy.");
+		};
+
+		template <typename Traits, template <typename Traits_> class HeuristicPolicy>
+		struct tie_heuristic<LowH<Traits, HeuristicPolicy>>
+		{
+			typedef heuristic_value<Traits, HeuristicPolicy> type;
+		};
+
+		template <typename Traits>
+		struct tie_heuristic<FalseTiePolicy<Traits>>
+		{
+			typedef heuristic_value<Traits, ZeroHeuristic> type;
+		};
+
+
+		/**
+		 * Nodes in buckets by f, each of those in buckets by h, each of those a stack.
+		 *
+		 * The top is the most recently pushed node of the lowest h among those of the
+		 * lowest f, as the comparator would choose, so no comparisons are made at all.
+		 * A bucket is found by indexing with f and h, which must therefore be small
+		 * non-negative integers: the buckets take memory for every value up to the
+		 * largest pushed.  Each bucket level has a cursor on its lowest non-empty
+		 * bucket that only moves back when a node goes in below it, so for a search
+		 * whose f never decreases, push, pop and decrease-key are O(1).
+		 *
+		 * As with indexed_d_ary_heap, the Map holds each node's position and every
+		 * node points back at its Map entry, which the Map must therefore not move.
+		 * Removing a node from the middle of a stack, as a decrease-key does, moves
+		 * the top of that stack into its place.
+		 */
+		template <typename T, class CostFunction, class Heuristic, template <typename Key, typename Value> class Map>
+		class fh_buckets
+		{
+			typedef decltype(std::declval<CostFunction const &>().f(std::declval<T const &>())) f_type;
+			typedef decltype(std::declval<Heuristic const &>()(std::declval<T const &>())) h_type;
+
+			static_assert(std::is_integral<f_type>::value && std::is_integral<h_type>::value, "bucket_queue: f and h must be integers.");
+
+		public:
+			typedef std::size_t size_type;
+			typedef T value_type;
+			typedef std::ptrdiff_t difference_type;
+
+			typedef T &reference;
+			typedef T const &const_reference;
+			typedef T *pointer;
+			typedef T const *const_pointer;
+
+			/** A position in the buckets.  Dereferencing it yields the element, as with a Boost.Heap handle. */
+			class handle_type
+			{
+				friend class fh_buckets;
+
+			public:
+				handle_type(size_type const F, size_type const H, size_type const INDEX, fh_buckets const *OWNER) : f(F), h(H), index(INDEX), owner(OWNER) {}
+
+				const_reference operator*() const { return owner->buckets[f].by_h[h][index].value; }
+
+			private:
+				size_type f, h, index;
+				fh_buckets const *owner;
+			};
+
+			typedef typename value_type::element_type::State key_type;
+			typedef handle_type mapped_type;
+
+		private:
+			typedef Map<key_type, mapped_type> StateHandleMap;
+
+		public:
+			typedef typename StateHandleMap::iterator       iterator;
+			typedef typename StateHandleMap::const_iterator const_iterator;
+			typedef typename StateHandleMap::reference		 map_reference;
+			typedef typename StateHandleMap::value_type     map_value_type;
+
+			fh_buckets() : size_(0), low_f(0) {}
+			fh_buckets(fh_buckets const &) = delete; // The Map would point into the wrong buckets.
+			fh_buckets &operator=(fh_buckets const &) = delete;
+
+			/**
+			 * Push @a NODE on to the top of its bucket.
+			 *
+			 * If a node with the same state is already on the queue, a logic_error exception is thrown.
+			 */
+			void push(value_type const &NODE)
+			{
+				auto const &STATE(NODE->state());
+				auto const INSERT_RESULT(map.insert(std::make_pair(STATE, handle_type(0, 0, 0, this))));
+
+				if(!INSERT_RESULT.second)
+				{
+					std::ostringstream tmp;
+					tmp << "Priority queue alreadys contains a state with this value: " << STATE;
+					throw std::logic_error(tmp.str()); // Client error.
+				}
+				insert(element(NODE, &INSERT_RESULT.first->second));
+			}
+
+			/** Erase the top element. */
+			void pop()
+			{
+				assert(size_);
+				auto &stack(buckets[low_f].by_h[buckets[low_f].low_h]);
+				auto const ERASED(map.erase(stack.back().value->state()));
+				assert(ERASED == 1);
+				(void)ERASED;
+				stack.pop_back();
+				--buckets[low_f].count;
+				--size_;
+				advance();
+			}
+
+			const_reference top() const { assert(size_); return buckets[low_f].by_h[buckets[low_f].low_h].back().value; }
+			bool empty() const { return size_ == 0; }
+			size_type size() const { return size_; }
+
+			/** Mutable interface, with the same meaning as in Boost.Heap.  Each moves the node to the bucket of its new f and h. */
+			void update(handle_type const &HANDLE, value_type const &NODE) { relocate(HANDLE, NODE); }
+			void increase(handle_type const &HANDLE, value_type const &NODE) { relocate(HANDLE, NODE); }
+			void decrease(handle_type const &HANDLE, value_type const &NODE) { relocate(HANDLE, NODE); }
+
+			/**
+			 *	Map iterable interface
+			 */
+			const_iterator begin() const { return map.cbegin(); }
+			const_iterator cbegin() const { return map.cbegin(); }
+			const_iterator end() const { return map.end(); }
+			const_iterator cend() const { return map.cend(); }
+
+			/**
+			 * Map lookup interface.
+			 */
+			mapped_type const &at(key_type const &KEY) const { return map.at(KEY); }
+			size_type count(key_type const &KEY) const { return map.count(KEY); }
+			const_iterator find(key_type const &KEY) const { return map.find(KEY); }
+			std::pair<const_iterator, const_iterator> equal_range(key_type const &KEY) const { return map.equal_range(KEY); }
+
+			void clear() { map.clear(); buckets.clear(); size_ = 0; low_f = 0; }
+			size_t max_size() const { return map.max_size(); }
+			void reserve(size_type count) { map.reserve(count); }
+
+		private:
+			struct element
+			{
+				element(value_type const &VALUE, handle_type *SLOT) : value(VALUE), slot(SLOT) {}
+
+				value_type value;
+				handle_type *slot; // The Map entry that holds this element's position.
+			};
+
+			struct f_bucket
+			{
+				f_bucket() : count(0), low_h(0) {}
+
+				size_type count; // Of elements in all of by_h.
+				size_type low_h; // No non-empty bucket of by_h is below it.
+				std::vector<std::vector<element>> by_h;
+			};
+
+			// Put E on the top of the bucket of its f and h.
+			void insert(element &&e)
+			{
+				size_type const F(COST.f(e.value)), H(HEURISTIC(e.value));
+				if(F >= buckets.size())
+					buckets.resize(F + 1);
+				auto &bucket(buckets[F]);
+				if(H >= bucket.by_h.size())
+					bucket.by_h.resize(H + 1);
+				auto &stack(bucket.by_h[H]);
+
+				*e.slot = handle_type(F, H, stack.size(), this);
+				stack.push_back(std::move(e));
+				if(bucket.count++ == 0 || H < bucket.low_h)
+					bucket.low_h = H;
+				if(size_++ == 0 || F < low_f)
+					low_f = F;
+			}
+
+			// Take the element at HANDLE out of its bucket and put it back with NODE as its value.
+			void relocate(handle_type const &HANDLE, value_type const &NODE)
+			{
+				assert(HANDLE.owner == this);
+				handle_type const OLD(HANDLE); // HANDLE is the Map entry, which insert() will overwrite.
+				auto &stack(buckets[OLD.f].by_h[OLD.h]);
+				element e(NODE, stack[OLD.index].slot);
+				if(OLD.index + 1 != stack.size())
+				{
+					stack[OLD.index] = std::move(stack.back());
+					stack[OLD.index].slot->index = OLD.index;
+				}
+				stack.pop_back();
+				--buckets[OLD.f].count;
+				--size_;
+				insert(std::move(e));
+				advance();
+			}
+
+			// Move the cursors up to the lowest non-empty buckets.
+			void advance()
+			{
+				if(size_ == 0)
+					return;
+				while(buckets[low_f].count == 0)
+					++low_f;
+				auto &bucket(buckets[low_f]);
+				while(bucket.by_h[bucket.low_h].empty())
+					++bucket.low_h;
+			}
+
+			StateHandleMap map; // State ↦ position in the buckets.
+			std::vector<f_bucket> buckets; // Indexed by f.
+			size_type size_;
+			size_type low_f; // No non-empty bucket is below it, and when size_ > 0 it is non-empty.
+			CostFunction const COST;
+			Heuristic const HEURISTIC;
+		};
+	}
+
+
+	template <typename T, typename Traits, template <typename Traits_> class CostPolicy, template <typename Traits_> class TiePolicy, template <typename Key, typename Value> class Map>
+	class queue_set<bucket_queue<T, TiebreakingComparator<Traits, CostPolicy, TiePolicy>>, Map> : public detail::fh_buckets<T, CostPolicy<Traits>, typename detail::tie_heuristic<TiePolicy<Traits>>::type, Map>
+	{
+	};
+
+
+	template <typename T, typename Traits, template <typename Traits_> class CostPolicy, template <typename Key, typename Value> class Map>
+	class queue_set<bucket_queue<T, SimpleComparator<Traits, CostPolicy>>, Map> : public detail::fh_buckets<T, CostPolicy<Traits>, detail::heuristic_value<Traits, ZeroHeuristic>, Map>
+	{
+	};
+} // end namespace jsearch
+
+#endif // JSEARCH_BUCKET_QUEUE_HPP
@@ -0,0 +1,86 @@
+#ifndef JSEARCH_CANCELLATION_HPP
+#define JSEARCH_CANCELLATION_HPP 1
+
+/*
+    cancellation.hpp: Stop a search from another thread.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Cancellation is cooperative.  Every engine polls the cancellation that is
+ * the current context on its thread, if there is one, once per expansion, and
+ * throws search_cancelled once it has been cancelled.  Any thread may cancel:
+ *
+ *   cancellation const CANCEL;
+ *
+ *   // On the searching thread:
+ *   context<cancellation> const SCOPE(CANCEL);
+ *   best_first_search<PriorityQueue, Comparator>(PROBLEM);
+ *
+ *   // On any other:
+ *   CANCEL.cancel();
+ *
+ * One cancellation may be the context of several threads at once, which is
+ * how a portfolio stops all of its searches together.
+ */
+
+#include "context.hpp"
+
+#include <atomic>
+#include <exception>
+
+
+namespace jsearch
+{
+	class search_cancelled : public std::exception
+	{
+	public:
+		search_cancelled() {}
+
+		char const *what() const noexcept { return "search cancelled"; }
+	};
+
+
+	class cancellation
+	{
+	public:
+		cancellation() : flag(false) {}
+
+		cancellation(cancellation const &) = delete;
+		cancellation &operator=(cancellation const &) = delete;
+
+		void cancel() const { flag.store(true, std::memory_order_relaxed); }
+
+		bool cancelled() const { return flag.load(std::memory_order_relaxed); }
+
+	private:
+		mutable std::atomic<bool> flag;
+	};
+
+
+	namespace detail
+	{
+		/** Throw search_cancelled if the current cancellation, if there is one, has been cancelled. */
+		inline void poll_cancellation()
+		{
+			if(auto const CANCEL = context<cancellation>::find())
+				if(CANCEL->cancelled())
+					throw search_cancelled();
+		}
+	}
+}
+
+#endif // JSEARCH_CANCELLATION_HPP
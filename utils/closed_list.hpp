@@ -0,0 +1,159 @@
+#ifndef JSEARCH_CLOSED_LIST_HPP
+#define JSEARCH_CLOSED_LIST_HPP 1
+
+/*
+    closed_list.hpp: Closed list policies deciding whether expanded states are re-opened.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * NOTE: This header was not designed to be included manually.  It will be
+ * included automatically by the main search header.
+ */
+
+#include <limits>
+#include <iterator>
+#include <utility>
+#include <cstddef>
+
+
+namespace jsearch
+{
+	/**
+	 * The closed list of graph search, given to best_first_search as its ClosedPolicy.
+	 *
+	 *  INTERFACE
+	 *
+	 *   void close(State const &STATE, PathCost const &G);
+	 *   	STATE has been expanded via a path of cost G.
+	 *
+	 *   template <typename PathCostFunction>
+	 *   bool admit(State const &STATE, PathCostFunction G);
+	 *   	May a new path to STATE go to the frontier?  G() returns the cost of
+	 *   	the new path and is only called if the policy needs it.
+	 *
+	 *   size_t reopened() const;
+	 *   	How many times a closed state has been expanded again.
+	 *
+	 * With a consistent heuristic the first expansion of a state is via an
+	 * optimal path and NeverReopen is both correct and cheapest.  Inconsistent
+	 * or weighted evaluation can expand a state before its best path is found,
+	 * in which case only re-opening recovers the true cost.
+	 */
+	template <typename Traits, template <typename T> class Set, template <typename Key, typename Value> class Map>
+	class NeverReopen
+	{
+	public:
+		typedef typename Traits::state State;
+		typedef typename Traits::pathcost PathCost;
+
+		void close(State const &STATE, PathCost const &) { closed.insert(STATE); }
+
+		template <typename PathCostFunction>
+		bool admit(State const &STATE, PathCostFunction const &) const { return closed.find(STATE) == std::end(closed); }
+
+		std::size_t reopened() const { return 0; }
+		std::size_t size() const { return closed.size(); }
+
+	private:
+		Set<State> closed;
+	};
+
+
+	/**
+	 * Record the best g of every closed state and re-open it up to Bound times
+	 * when a cheaper path to it is generated.
+	 *
+	 * A re-opened state is back on the frontier, where a still cheaper path to
+	 * it is a decrease-key, so it is admitted regardless until it is closed
+	 * again.  Only that second close() counts as a re-opening.
+	 *
+	 * Bound is a fourth template parameter, which a ClosedPolicy does not have,
+	 * so it is given through an alias:
+	 *
+	 *   template <typename Traits, template <typename T> class Set, template <typename Key, typename Value> class Map>
+	 *   using ReopenOnce = BoundedReopen<Traits, Set, Map, 1>;
+	 */
+	template <typename Traits, template <typename T> class Set, template <typename Key, typename Value> class Map, unsigned Bound>
+	class BoundedReopen
+	{
+	public:
+		typedef typename Traits::state State;
+		typedef typename Traits::pathcost PathCost;
+
+		BoundedReopen() : reopened_(0) {}
+
+		void close(State const &STATE, PathCost const &G)
+		{
+			auto const INSERT_RESULT(closed.insert(std::make_pair(STATE, record(G))));
+			if(!INSERT_RESULT.second)
+			{
+				auto &RECORD(INSERT_RESULT.first->second);
+				RECORD.g = G;
+				RECORD.open = false;
+				++RECORD.reopened;
+				++reopened_;
+			}
+		}
+
+		template <typename PathCostFunction>
+		bool admit(State const &STATE, PathCostFunction const &G)
+		{
+			auto const IT(closed.find(STATE));
+
+			if(IT == std::end(closed))
+				return true;
+
+			auto &RECORD(IT->second);
+			if(RECORD.open)
+				return true;
+
+			if(RECORD.reopened == Bound)
+				return false;
+
+			auto const NEW_G(G());
+			if(!(NEW_G < RECORD.g))
+				return false;
+
+			RECORD.g = NEW_G;
+			RECORD.open = true;
+			return true;
+		}
+
+		std::size_t reopened() const { return reopened_; }
+		std::size_t size() const { return closed.size(); }
+
+	private:
+		struct record
+		{
+			record(PathCost const &G) : g(G), reopened(0), open(false) {}
+
+			PathCost g;
+			unsigned reopened; // How many times it has been closed again.
+			bool open; // Admitted again and not yet closed again.
+		};
+
+		Map<State, record> closed;
+		std::size_t reopened_;
+	};
+
+
+	/** Re-open a closed state whenever a cheaper path to it is generated. */
+	template <typename Traits, template <typename T> class Set, template <typename Key, typename Value> class Map>
+	using AlwaysReopen = BoundedReopen<Traits, Set, Map, std::numeric_limits<unsigned>::max()>;
+} // end namespace jsearch
+
+#endif // JSEARCH_CLOSED_LIST_HPP
@@ -0,0 +1,82 @@
+#ifndef JSEARCH_CONTEXT_HPP
+#define JSEARCH_CONTEXT_HPP 1
+
+/*
+    context.hpp: The problem instance that the policies on a thread refer to.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cassert>
+
+
+namespace jsearch
+{
+	/**
+	 * Make INSTANCE the current instance of its type on this thread, for the lifetime of the context.
+	 *
+	 * Policies are default-constructed mixins and comparators are constructed by
+	 * the priority queue, so nothing can hand them the data of the instance being
+	 * solved.  Instead, whoever runs a search creates a context for its instance
+	 * and the policies look it up with context<Instance>::get().  Each thread has
+	 * its own current instance, so different threads can solve different
+	 * instances at the same time.  Contexts nest: the previous instance is
+	 * restored when a context is destroyed.
+	 *
+	 *   tsp_instance const INSTANCE(...);
+	 *   jsearch::context<tsp_instance> const CONTEXT(INSTANCE);
+	 *   auto const SOLUTION(jsearch::best_first_search<...>(PROBLEM));
+	 */
+	template <typename Instance>
+	class context
+	{
+	public:
+		explicit context(Instance const &INSTANCE) : previous(current())
+		{
+			current() = &INSTANCE;
+		}
+
+		~context()
+		{
+			current() = previous;
+		}
+
+		context(context const &) = delete;
+		context &operator=(context const &) = delete;
+
+		static Instance const &get()
+		{
+			assert(current());
+			return *current();
+		}
+
+		/** The current instance, or nullptr if there is none. */
+		static Instance const *find()
+		{
+			return current();
+		}
+
+	private:
+		static Instance const *&current()
+		{
+			static thread_local Instance const *instance(nullptr);
+			return instance;
+		}
+
+		Instance const *previous;
+	};
+}
+
+#endif // JSEARCH_CONTEXT_HPP
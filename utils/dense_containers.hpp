@@ -0,0 +1,463 @@
+#ifndef JSEARCH_DENSE_CONTAINERS_HPP
+#define JSEARCH_DENSE_CONTAINERS_HPP 1
+
+/*
+    dense_containers.hpp: Set and Map for states that are dense integer ids.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * NOTE: This header was not designed to be included manually.  It will be
+ * included automatically by the main search header.
+ */
+
+/*
+ * When the states are integers 0 .. n-1, as the vertices of a graph (see
+ * graph.hpp) are, the closed list and the frontier's index need not hash
+ * anything: a state is its own position in an array.  dense_set and dense_map
+ * provide as much of the std::unordered_set and std::unordered_map interfaces
+ * as the search engines use, so they can be given as the Set and Map template
+ * parameters directly:
+ *
+ *   best_first_search<PriorityQueue, Comparator, dense_set, dense_map>(PROBLEM, path);
+ *
+ * Each entry is stamped with the generation of the container in which it was
+ * made, so clear() is O(1): it starts a new generation and every older entry
+ * is thereby absent.  The arrays grow to the largest state seen, so memory is
+ * O(largest state), not O(size()), and iteration visits every position.  Their
+ * memory comes from the Allocator, rebound as necessary.
+ */
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace jsearch
+{
+	namespace detail
+	{
+		template <typename Key>
+		inline std::size_t dense_id(Key const &KEY)
+		{
+			static_assert(std::is_integral<Key>::value || std::is_enum<Key>::value, "Dense containers need integral keys.");
+			return static_cast<std::size_t>(KEY);
+		}
+	}
+
+
+	/**
+	 * A set of integers as an array of generation stamps, one per possible member.
+	 * Insertion, look-up, erasure and clear() are all O(1).
+	 */
+	template <typename T, typename Allocator = std::allocator<T>>
+	class dense_set
+	{
+		typedef std::uint32_t stamp_type;
+
+	public:
+		typedef T key_type;
+		typedef T value_type;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		class const_iterator
+		{
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef T value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef T const *pointer;
+			typedef T reference; // Members are not stored, only marked, so they are made on demand.
+
+			const_iterator() : owner(nullptr), index(0) {}
+
+			reference operator*() const { return static_cast<T>(index); }
+
+			const_iterator &operator++()
+			{
+				index = owner->next(index + 1);
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const_iterator const RESULT(*this);
+				++*this;
+				return RESULT;
+			}
+
+			bool operator==(const_iterator const &OTHER) const { return index == OTHER.index; }
+			bool operator!=(const_iterator const &OTHER) const { return index != OTHER.index; }
+
+		private:
+			friend class dense_set;
+
+			const_iterator(dense_set const *OWNER, std::size_t const INDEX) : owner(OWNER), index(INDEX) {}
+
+			dense_set const *owner;
+			std::size_t index;
+		};
+
+		typedef const_iterator iterator;
+
+		dense_set() : generation(1), size_(0) {}
+
+		std::pair<iterator, bool> insert(T const &KEY)
+		{
+			auto const I(detail::dense_id(KEY));
+			if(I >= stamps.size())
+				stamps.resize(std::max(I + 1, 2 * stamps.size()), 0);
+			bool const INSERTED(stamps[I] != generation);
+			if(INSERTED)
+			{
+				stamps[I] = generation;
+				++size_;
+			}
+			return std::make_pair(iterator(this, I), INSERTED);
+		}
+
+		iterator find(T const &KEY) const
+		{
+			auto const I(detail::dense_id(KEY));
+			return contains(I) ? iterator(this, I) : end();
+		}
+
+		size_type count(T const &KEY) const { return contains(detail::dense_id(KEY)) ? 1 : 0; }
+
+		size_type erase(T const &KEY)
+		{
+			auto const I(detail::dense_id(KEY));
+			if(!contains(I))
+				return 0;
+			stamps[I] = 0;
+			--size_;
+			return 1;
+		}
+
+		iterator erase(const_iterator const POSITION)
+		{
+			stamps[POSITION.index] = 0;
+			--size_;
+			return iterator(this, next(POSITION.index + 1));
+		}
+
+		void clear()
+		{
+			size_ = 0;
+			if(++generation == 0) // After four billion clears, really start again.
+			{
+				std::fill(std::begin(stamps), std::end(stamps), 0);
+				generation = 1;
+			}
+		}
+
+		/** Make room for the members 0 .. COUNT - 1. */
+		void reserve(size_type const COUNT)
+		{
+			if(COUNT > stamps.size())
+				stamps.resize(COUNT, 0);
+		}
+
+		const_iterator begin() const { return const_iterator(this, next(0)); }
+		const_iterator end() const { return const_iterator(this, stamps.size()); }
+		const_iterator cbegin() const { return begin(); }
+		const_iterator cend() const { return end(); }
+
+		size_type size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+		size_type max_size() const { return stamps.max_size(); }
+
+	private:
+		bool contains(std::size_t const I) const { return I < stamps.size() && stamps[I] == generation; }
+
+		std::size_t next(std::size_t i) const
+		{
+			while(i < stamps.size() && stamps[i] != generation)
+				++i;
+			return i;
+		}
+
+		std::vector<stamp_type, typename std::allocator_traits<Allocator>::template rebind_alloc<stamp_type>> stamps;
+		stamp_type generation;
+		size_type size_;
+	};
+
+
+	/**
+	 * A map from integers to Value as an array of slots, one per possible key.
+	 *
+	 * The slots are allocated in pages, on the first insertion into each, that never move, so the address of a mapped
+	 * value is stable until it is erased, as with std::unordered_map.  (The indexed
+	 * heap relies on that.)  Insertion, look-up, erasure and clear() are all O(1);
+	 * the values of a cleared generation are destroyed when their slots are reused
+	 * or the map is destroyed.
+	 */
+	template <typename Key, typename Value, typename Allocator = std::allocator<std::pair<Key const, Value>>>
+	class dense_map
+	{
+		typedef std::uint32_t stamp_type;
+
+	public:
+		typedef Key key_type;
+		typedef Value mapped_type;
+		typedef std::pair<Key const, Value> value_type;
+		typedef value_type &reference;
+		typedef value_type const &const_reference;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+	private:
+		struct slot
+		{
+			slot() : stamp(0) {}
+
+			value_type &value() { return *reinterpret_cast<value_type *>(&storage); }
+
+			stamp_type stamp; // 0: no value; otherwise the generation of the value.
+			typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type storage;
+		};
+
+		template <typename Owner, typename Reference>
+		class iterator_base
+		{
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef typename dense_map::value_type value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef typename std::remove_reference<Reference>::type *pointer;
+			typedef Reference reference;
+
+			iterator_base() : owner(nullptr), index(0) {}
+
+			// Converts iterator to const_iterator.
+			template <typename Owner_, typename Reference_>
+			iterator_base(iterator_base<Owner_, Reference_> const &OTHER) : owner(OTHER.owner), index(OTHER.index) {}
+
+			reference operator*() const { return owner->at_index(index).value(); }
+			pointer operator->() const { return &**this; }
+
+			iterator_base &operator++()
+			{
+				index = owner->next(index + 1);
+				return *this;
+			}
+
+			iterator_base operator++(int)
+			{
+				iterator_base const RESULT(*this);
+				++*this;
+				return RESULT;
+			}
+
+			template <typename Owner_, typename Reference_>
+			bool operator==(iterator_base<Owner_, Reference_> const &OTHER) const { return index == OTHER.index; }
+
+			template <typename Owner_, typename Reference_>
+			bool operator!=(iterator_base<Owner_, Reference_> const &OTHER) const { return index != OTHER.index; }
+
+		private:
+			friend class dense_map;
+			template <typename Owner_, typename Reference_> friend class iterator_base;
+
+			iterator_base(Owner *OWNER, std::size_t const INDEX) : owner(OWNER), index(INDEX) {}
+
+			Owner *owner;
+			std::size_t index;
+		};
+
+	public:
+		typedef iterator_base<dense_map, value_type &> iterator;
+		typedef iterator_base<dense_map const, value_type const &> const_iterator;
+
+		dense_map() : capacity(0), generation(1), size_(0) {}
+
+		~dense_map()
+		{
+			destroy_all();
+			for(auto const PAGE : pages)
+				if(PAGE)
+					SlotTraits::deallocate(slots, PAGE, PAGE_SIZE);
+		}
+
+		dense_map(dense_map const &) = delete;
+		dense_map &operator=(dense_map const &) = delete;
+
+		std::pair<iterator, bool> insert(value_type const &VALUE)
+		{
+			auto const I(detail::dense_id(VALUE.first));
+			grow(I + 1);
+			auto &page(pages[I >> PAGE_BITS]);
+			if(!page)
+			{
+				page = SlotTraits::allocate(slots, PAGE_SIZE);
+				std::uninitialized_fill_n(page, PAGE_SIZE, slot());
+			}
+			slot &s(page[I & (PAGE_SIZE - 1)]);
+			if(s.stamp == generation)
+				return std::make_pair(iterator(this, I), false);
+			destroy(s); // A value left over from an earlier generation.
+			new (&s.storage) value_type(VALUE);
+			s.stamp = generation;
+			++size_;
+			return std::make_pair(iterator(this, I), true);
+		}
+
+		iterator find(Key const &KEY)
+		{
+			auto const I(detail::dense_id(KEY));
+			return contains(I) ? iterator(this, I) : end();
+		}
+
+		const_iterator find(Key const &KEY) const
+		{
+			auto const I(detail::dense_id(KEY));
+			return contains(I) ? const_iterator(this, I) : end();
+		}
+
+		std::pair<const_iterator, const_iterator> equal_range(Key const &KEY) const
+		{
+			auto const FIRST(find(KEY));
+			auto last(FIRST);
+			return std::make_pair(FIRST, FIRST == end() ? last : ++last);
+		}
+
+		Value &at(Key const &KEY)
+		{
+			auto const I(detail::dense_id(KEY));
+			if(!contains(I))
+				throw std::out_of_range("dense_map::at");
+			return at_index(I).value().second;
+		}
+
+		Value const &at(Key const &KEY) const { return const_cast<dense_map &>(*this).at(KEY); }
+
+		size_type count(Key const &KEY) const { return contains(detail::dense_id(KEY)) ? 1 : 0; }
+
+		size_type erase(Key const &KEY)
+		{
+			auto const I(detail::dense_id(KEY));
+			if(!contains(I))
+				return 0;
+			erase_index(I);
+			return 1;
+		}
+
+		iterator erase(const_iterator const POSITION)
+		{
+			erase_index(POSITION.index);
+			return iterator(this, next(POSITION.index + 1));
+		}
+
+		void clear()
+		{
+			size_ = 0;
+			if(++generation == 0) // After four billion clears, really start again.
+			{
+				destroy_all();
+				generation = 1;
+			}
+		}
+
+		/** Make room for the keys 0 .. COUNT - 1. */
+		void reserve(size_type const COUNT) { grow(COUNT); }
+
+		iterator begin() { return iterator(this, next(0)); }
+		iterator end() { return iterator(this, capacity); }
+		const_iterator begin() const { return const_iterator(this, next(0)); }
+		const_iterator end() const { return const_iterator(this, capacity); }
+		const_iterator cbegin() const { return begin(); }
+		const_iterator cend() const { return end(); }
+
+		size_type size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+		size_type max_size() const { return std::numeric_limits<std::ptrdiff_t>::max() / sizeof(slot); }
+
+	private:
+		static constexpr std::size_t PAGE_BITS = 10, PAGE_SIZE = std::size_t(1) << PAGE_BITS;
+
+		// Only for a key whose page exists.
+		slot &at_index(std::size_t const I) const { return pages[I >> PAGE_BITS][I & (PAGE_SIZE - 1)]; }
+
+		bool contains(std::size_t const I) const
+		{
+			return I < capacity && pages[I >> PAGE_BITS] && at_index(I).stamp == generation;
+		}
+
+		std::size_t next(std::size_t i) const
+		{
+			while(i < capacity && !contains(i))
+				i = pages[i >> PAGE_BITS] ? i + 1 : ((i >> PAGE_BITS) + 1) << PAGE_BITS;
+			return i;
+		}
+
+		// Only the table of pages grows here; the pages themselves are made by insert.
+		void grow(std::size_t const COUNT)
+		{
+			if(capacity < COUNT)
+			{
+				pages.resize(std::max((COUNT + PAGE_SIZE - 1) >> PAGE_BITS, 2 * pages.size()));
+				capacity = pages.size() << PAGE_BITS;
+			}
+		}
+
+		void destroy_all()
+		{
+			for(auto const &PAGE : pages)
+				if(PAGE)
+					std::for_each(PAGE, PAGE + PAGE_SIZE, destroy);
+		}
+
+		void erase_index(std::size_t const I)
+		{
+			destroy(at_index(I));
+			--size_;
+		}
+
+		static void destroy(slot &s)
+		{
+			if(s.stamp != 0)
+			{
+				s.value().~value_type();
+				s.stamp = 0;
+			}
+		}
+
+		typedef std::allocator_traits<typename std::allocator_traits<Allocator>::template rebind_alloc<slot>> SlotTraits;
+
+		typename SlotTraits::allocator_type slots;
+		std::vector<slot *, typename std::allocator_traits<Allocator>::template rebind_alloc<slot *>> pages;
+		std::size_t capacity;
+		stamp_type generation;
+		size_type size_;
+	};
+
+	template <typename Key, typename Value, typename Allocator>
+	constexpr std::size_t dense_map<Key, Value, Allocator>::PAGE_BITS;
+
+	template <typename Key, typename Value, typename Allocator>
+	constexpr std::size_t dense_map<Key, Value, Allocator>::PAGE_SIZE;
+} // end namespace jsearch
+
+#endif // JSEARCH_DENSE_CONTAINERS_HPP
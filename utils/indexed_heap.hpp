@@ -0,0 +1,284 @@
+#ifndef JSEARCH_INDEXED_HEAP_HPP
+#define JSEARCH_INDEXED_HEAP_HPP 1
+
+/*
+    indexed_heap.hpp: Indexed d-ary heap that doubles as its own state lookup.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * NOTE: This header was not designed to be included manually.  It will be
+ * included automatically by the main search header.
+ */
+
+#include "queue_set.hpp"
+
+#include <vector>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <limits>
+#include <cstddef>
+#include <cassert>
+
+
+namespace jsearch
+{
+	/**
+	 * Selector for the indexed d-ary heap frontier.
+	 *
+	 * It is never defined: it only exists so that it can be named in the
+	 * PriorityQueue template alias given to best_first_search, e.g.
+	 *
+	 *   template <typename T, typename Comparator>
+	 *   using PriorityQueue = jsearch::indexed_d_ary_heap<T, Comparator, 4>;
+	 *
+	 * which selects the queue_set specialization below.  The heap array's memory
+	 * comes from Allocator, rebound to its element type.
+	 */
+	template <typename T, typename Comparator, std::size_t Arity = 4, typename Allocator = std::allocator<T>>
+	struct indexed_d_ary_heap;
+
+
+	/**
+	 * A d-ary heap whose Map goes straight from State to heap position.
+	 *
+	 * The general queue_set keeps a Boost heap plus a Map from State to heap
+	 * handle, so every operation is a hash probe plus whatever the heap does
+	 * behind its handles.  Here the Map holds the position of the element in
+	 * the heap array and every heap element points back at its own Map entry,
+	 * so sifting moves positions without touching the hash table.  The result
+	 * is exactly one probe per push, pop or find.
+	 *
+	 * Elements (the node pointer and its back-pointer) are stored contiguously
+	 * in one array, so a sift touches Arity adjacent elements per level.
+	 *
+	 * NOTE: The back-pointers require that the Map never moves its mapped
+	 * values after insertion, which holds for the node-based standard maps.
+	 */
+	template <typename T, typename Comparator, std::size_t Arity, typename Allocator, template <typename Key, typename Value> class Map>
+	class queue_set<indexed_d_ary_heap<T, Comparator, Arity, Allocator>, Map>
+	{
+		static_assert(Arity > 1, "Arity of the heap must be at least 2.");
+
+	public:
+		typedef std::size_t size_type;
+		typedef T value_type;
+		typedef std::ptrdiff_t difference_type;
+
+		typedef T &reference;
+		typedef T const &const_reference;
+		typedef T *pointer;
+		typedef T const *const_pointer;
+
+		/**
+		 * The handle is what the Map stores: a position in the heap array.
+		 * Dereferencing it yields the element, as with a Boost.Heap handle.
+		 */
+		class handle_type
+		{
+			friend class queue_set;
+
+		public:
+			handle_type(size_type const INDEX, queue_set const *OWNER) : index(INDEX), owner(OWNER) {}
+
+			const_reference operator*() const { return owner->heap[index].value; }
+
+		private:
+			size_type index;
+			queue_set const *owner;
+		};
+
+		typedef typename value_type::element_type::State key_type;
+		typedef handle_type mapped_type;
+
+	private:
+		typedef Map<key_type, mapped_type> StateHandleMap;
+
+	public:
+		typedef typename StateHandleMap::iterator       iterator;
+		typedef typename StateHandleMap::const_iterator const_iterator;
+		typedef typename StateHandleMap::reference		 map_reference;
+		typedef typename StateHandleMap::value_type     map_value_type;
+
+		queue_set() {}
+		queue_set(queue_set const &) = delete; // The Map would point into the wrong heap.
+		queue_set &operator=(queue_set const &) = delete;
+
+		/**
+		 * Push @a NODE on to the heap.
+		 *
+		 * If a node with the same state is already on the heap, a logic_error exception is thrown.
+		 */
+		void push(value_type const &NODE);
+
+		/**
+		 * Erase the lowest-cost element from the heap.
+		 * Worst-case time complexity: O(d log_d n).
+		 */
+		void pop();
+
+		const_reference top() const { assert(!heap.empty()); return heap.front().value; }
+		bool empty() const { return heap.empty(); }
+		size_type size() const { return heap.size(); }
+
+		/** Mutable interface, with the same meaning as in Boost.Heap. */
+		void update(handle_type const &HANDLE, value_type const &NODE) { auto const I(replace(HANDLE, NODE)); sift_down(sift_up(I)); }
+		void increase(handle_type const &HANDLE, value_type const &NODE) { sift_up(replace(HANDLE, NODE)); }
+		void decrease(handle_type const &HANDLE, value_type const &NODE) { sift_down(replace(HANDLE, NODE)); }
+
+		/**
+		 *	Map iterable interface
+		 */
+		const_iterator begin() const { return map.cbegin(); }
+		const_iterator cbegin() const { return map.cbegin(); }
+		const_iterator end() const { return map.end(); }
+		const_iterator cend() const { return map.cend(); }
+
+		/**
+		 * Map lookup interface.
+		 */
+		mapped_type const &at(key_type const &KEY) const { return map.at(KEY); }
+		size_type count(key_type const &KEY) const { return map.count(KEY); }
+		const_iterator find(key_type const &KEY) const { return map.find(KEY); }
+		std::pair<const_iterator, const_iterator> equal_range(key_type const &KEY) const { return map.equal_range(KEY); }
+
+		void clear() { map.clear(); heap.clear(); }
+		size_t max_size() const { return std::min(map.max_size(), heap.max_size()); }
+		void reserve(size_type count) { map.reserve(count); heap.reserve(count); }
+
+	private:
+		struct element
+		{
+			element(value_type const &VALUE, handle_type *SLOT) : value(VALUE), slot(SLOT) {}
+
+			value_type value;
+			handle_type *slot; // The Map entry that holds this element's position.
+		};
+
+		// Put NODE in the place of the element at HANDLE, returning its position.
+		size_type replace(handle_type const &HANDLE, value_type const &NODE)
+		{
+			assert(HANDLE.owner == this);
+			assert(HANDLE.index < heap.size());
+			heap[HANDLE.index].value = NODE;
+			return HANDLE.index;
+		}
+
+		// Move E to position J and tell its Map entry about it.
+		void place(element &&E, size_type const J)
+		{
+			E.slot->index = J;
+			heap[J] = std::move(E);
+		}
+
+		size_type sift_up(size_type i);
+		void sift_down(size_type i);
+
+		StateHandleMap map; // State ↦ position in heap.
+		std::vector<element, typename std::allocator_traits<Allocator>::template rebind_alloc<element>> heap;
+		Comparator compare;
+	};
+
+// ---------------------------------------------------------------------
+
+	template <typename T, typename Comparator, std::size_t Arity, typename Allocator, template <typename Key, typename Value> class Map>
+	inline void queue_set<indexed_d_ary_heap<T, Comparator, Arity, Allocator>, Map>::push(value_type const &NODE)
+	{
+		auto const &STATE(NODE->state());
+		auto const INSERT_RESULT(map.insert(std::make_pair(STATE, handle_type(heap.size(), this))));
+
+		if(INSERT_RESULT.second)
+		{
+			heap.emplace_back(NODE, &INSERT_RESULT.first->second);
+			sift_up(heap.size() - 1);
+		}
+		else
+		{
+			std::ostringstream tmp;
+			tmp << "Priority queue alreadys contains a state with this value: " << STATE;
+			throw std::logic_error(tmp.str()); // Client error.
+		}
+	}
+
+
+	template <typename T, typename Comparator, std::size_t Arity, typename Allocator, template <typename Key, typename Value> class Map>
+	inline void queue_set<indexed_d_ary_heap<T, Comparator, Arity, Allocator>, Map>::pop()
+	{
+		assert(!heap.empty());
+		auto const ERASED(map.erase(heap.front().value->state()));
+		assert(ERASED == 1);
+		(void)ERASED;
+
+		if(heap.size() > 1)
+		{
+			place(std::move(heap.back()), 0);
+			heap.pop_back();
+			sift_down(0);
+		}
+		else
+			heap.pop_back();
+	}
+
+
+	template <typename T, typename Comparator, std::size_t Arity, typename Allocator, template <typename Key, typename Value> class Map>
+	inline typename queue_set<indexed_d_ary_heap<T, Comparator, Arity, Allocator>, Map>::size_type
+	queue_set<indexed_d_ary_heap<T, Comparator, Arity, Allocator>, Map>::sift_up(size_type i)
+	{
+		element e(std::move(heap[i]));
+
+		while(i > 0)
+		{
+			auto const PARENT((i - 1) / Arity);
+			if(!compare(heap[PARENT].value, e.value))
+				break;
+			place(std::move(heap[PARENT]), i);
+			i = PARENT;
+		}
+
+		place(std::move(e), i);
+		return i;
+	}
+
+
+	template <typename T, typename Comparator, std::size_t Arity, typename Allocator, template <typename Key, typename Value> class Map>
+	inline void queue_set<indexed_d_ary_heap<T, Comparator, Arity, Allocator>, Map>::sift_down(size_type i)
+	{
+		auto const SIZE(heap.size());
+		element e(std::move(heap[i]));
+
+		for(auto first(Arity * i + 1); first < SIZE; first = Arity * i + 1)
+		{
+			// Find the best of the (up to) Arity children, which are adjacent in memory.
+			auto const LAST(std::min(first + Arity, SIZE));
+			auto best(first);
+			for(auto child(first + 1); child < LAST; ++child)
+				if(compare(heap[best].value, heap[child].value))
+					best = child;
+
+			if(!compare(e.value, heap[best].value))
+				break;
+			place(std::move(heap[best]), i);
+			i = best;
+		}
+
+		place(std::move(e), i);
+	}
+} // end namespace jsearch
+
+#endif // JSEARCH_INDEXED_HEAP_HPP
@@ -0,0 +1,97 @@
+#ifndef JSEARCH_MAPPED_FILE_HPP
+#define JSEARCH_MAPPED_FILE_HPP 1
+
+/*
+    mapped_file.hpp: A whole file mapped read-only into memory.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <cstddef>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace jsearch
+{
+	/**
+	 * A read-only mapping of the whole of a file, for loaders that parse it in place.
+	 * ADVICE is given to madvise: sequential for a parser, normal for data that is
+	 * used where it is.  Throws std::runtime_error if the file cannot be opened or mapped.
+	 */
+	class mapped_file
+	{
+	public:
+		explicit mapped_file(std::string const &PATH, int const ADVICE = MADV_SEQUENTIAL) : data_(nullptr), size_(0)
+		{
+			int const FD(::open(PATH.c_str(), O_RDONLY));
+			if(FD == -1)
+				fail(PATH);
+
+			struct stat status;
+			if(::fstat(FD, &status) == -1)
+			{
+				::close(FD);
+				fail(PATH);
+			}
+
+			size_ = status.st_size;
+			if(size_ != 0) // mmap rejects a length of zero.
+			{
+				void *const DATA(::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, FD, 0));
+				if(DATA == MAP_FAILED)
+				{
+					::close(FD);
+					fail(PATH);
+				}
+				data_ = static_cast<char const *>(DATA);
+				::madvise(DATA, size_, ADVICE);
+			}
+
+			::close(FD);
+		}
+
+		~mapped_file()
+		{
+			if(data_)
+				::munmap(const_cast<char *>(data_), size_);
+		}
+
+		mapped_file(mapped_file const &) = delete;
+		mapped_file &operator=(mapped_file const &) = delete;
+
+		char const *begin() const { return data_; }
+		char const *end() const { return data_ + size_; }
+		std::size_t size() const { return size_; }
+
+	private:
+		static void fail(std::string const &PATH)
+		{
+			throw std::runtime_error(PATH + ": " + std::strerror(errno));
+		}
+
+		char const *data_;
+		std::size_t size_;
+	};
+}
+
+#endif // JSEARCH_MAPPED_FILE_HPP
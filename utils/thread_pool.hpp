@@ -0,0 +1,146 @@
+#ifndef JSEARCH_THREAD_POOL_HPP
+#define JSEARCH_THREAD_POOL_HPP 1
+
+/*
+    thread_pool.hpp: A small fixed-size thread pool.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * The search engines themselves are sequential: the frontier and the closed
+ * list are updated one child at a time.  The pool runs whole searches side by
+ * side, as a portfolio does, or makes the children of one expansion, as
+ * ParallelChildPolicy does.
+ */
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+
+namespace jsearch
+{
+	class thread_pool
+	{
+	public:
+		/**
+		 * @param THREADS Total number of threads that run a job, including the caller.
+		 */
+		explicit thread_pool(unsigned const THREADS = std::max(1u, std::thread::hardware_concurrency())) : job(nullptr), jobs(0), tasks(0), next(0), running(0), stop(false)
+		{
+			for(unsigned i(1); i < THREADS; ++i)
+				workers.emplace_back([this]{ work(); });
+		}
+
+		~thread_pool()
+		{
+			{
+				std::lock_guard<std::mutex> const LOCK(mutex);
+				stop = true;
+			}
+			wake.notify_all();
+			for(auto &worker : workers)
+				worker.join();
+		}
+
+		thread_pool(thread_pool const &) = delete;
+		thread_pool &operator=(thread_pool const &) = delete;
+
+		unsigned size() const { return workers.size() + 1; }
+
+		/**
+		 * Call TASK(i) for every i in [0, N) across the pool and wait for them all.
+		 * The calling thread takes part.  The first exception thrown by a task is
+		 * rethrown here once every task has finished.
+		 */
+		void run(std::size_t const N, std::function<void(std::size_t)> const &TASK)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			job = &TASK;
+			tasks = N;
+			next = 0;
+			error = nullptr;
+			++jobs;
+			lock.unlock();
+			wake.notify_all();
+
+			lock.lock();
+			help(lock);
+			done.wait(lock, [this]{ return next == tasks && running == 0; });
+			job = nullptr;
+
+			if(error)
+				std::rethrow_exception(error);
+		}
+
+	private:
+		// Take tasks from the current job until there are none left.  Called with the lock held.
+		void help(std::unique_lock<std::mutex> &lock)
+		{
+			while(next < tasks)
+			{
+				auto const I(next++);
+				++running;
+				lock.unlock();
+				try
+				{
+					(*job)(I);
+				}
+				catch(...)
+				{
+					lock.lock();
+					if(!error)
+						error = std::current_exception();
+					lock.unlock();
+				}
+				lock.lock();
+				--running;
+			}
+		}
+
+		void work()
+		{
+			std::size_t seen(0);
+			std::unique_lock<std::mutex> lock(mutex);
+
+			for(;;)
+			{
+				wake.wait(lock, [&]{ return stop || jobs != seen; });
+				if(stop)
+					return;
+				seen = jobs;
+				help(lock);
+				if(running == 0)
+					done.notify_all();
+			}
+		}
+
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable wake, done;
+		std::function<void(std::size_t)> const *job;
+		std::exception_ptr error;
+		std::size_t jobs, tasks, next, running;
+		bool stop;
+	};
+}
+
+#endif // JSEARCH_THREAD_POOL_HPP
@@ -0,0 +1,217 @@
+#ifndef JSEARCH_TRACE_HPP
+#define JSEARCH_TRACE_HPP 1
+
+/*
+    trace.hpp: Record what a search does to a binary file for offline analysis.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * The graph searches report each node they start from, expand and generate to
+ * the trace_recorder that is the current context on their thread, if there is
+ * one.  So tracing is switched on at run time, in any build, by scoping a
+ * recorder around the searches to be traced:
+ *
+ *   trace_recorder const TRACE("search.trace");
+ *   context<trace_recorder> const SCOPE(TRACE);
+ *   best_first_search<PriorityQueue, Comparator, ClosedList, Map>(PROBLEM, path);
+ *
+ * With no recorder, each event costs a test of a thread-local pointer.
+ *
+ * A trace file is MAGIC followed by trace_records in the byte order of the
+ * machine that wrote it.  The recorder collects them in a fixed buffer and
+ * writes the buffer out whenever it fills, on flush() and when it is
+ * destroyed.  The trace_summary tool reads it back.
+ */
+
+#include "context.hpp"
+#include "../evaluation.hpp"
+
+#include <array>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <functional>
+
+
+namespace jsearch
+{
+	enum class trace_event : std::uint32_t
+	{
+		START,		// The initial node of a search went on the frontier.
+		EXPAND,		// A node came off the frontier.
+		GENERATE,	// A child went on the frontier.
+		DUPLICATE,	// A child was thrown away for a duplicate on the frontier that is no worse.
+		DECREASE,	// A child replaced a worse duplicate on the frontier.
+		CLOSED		// A child was thrown away because its state has been expanded.
+	};
+
+
+	/**
+	 * One event.  The state is identified by its std::hash, or 0 if it has none.
+	 * f and h are as the cost function of the search's comparator evaluates the
+	 * node, or NaN if the search cannot tell (see detail::trace_evaluation).
+	 */
+	struct trace_record
+	{
+		std::uint64_t nanoseconds; // Since the recorder was made.
+		std::uint64_t state;
+		double g, h, f;
+		trace_event event;
+		std::uint32_t reserved;
+	};
+
+	static_assert(sizeof(trace_record) == 48, "trace_record is not packed as the file format expects.");
+
+
+	class trace_recorder
+	{
+	public:
+		static constexpr std::array<char, 8> MAGIC{{'J', 'S', 'T', 'R', 'A', 'C', 'E', '2'}};
+
+		/** Write to the file at PATH, buffering up to CAPACITY records. */
+		explicit trace_recorder(std::string const &PATH, std::size_t const CAPACITY = 1 << 14) : file(PATH, std::ios::binary | std::ios::trunc), buffer(CAPACITY), used(0), written(0), start(std::chrono::steady_clock::now())
+		{
+			if(!file)
+				throw std::runtime_error(PATH + ": cannot be opened for writing.");
+			file.write(MAGIC.data(), MAGIC.size());
+		}
+
+		~trace_recorder()
+		{
+			flush();
+		}
+
+		trace_recorder(trace_recorder const &) = delete;
+		trace_recorder &operator=(trace_recorder const &) = delete;
+
+		void record(trace_event const EVENT, std::uint64_t const STATE, double const G, double const H, double const F) const
+		{
+			if(used == buffer.size())
+				flush();
+			auto &r(buffer[used++]);
+			r.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			r.state = STATE;
+			r.g = G;
+			r.h = H;
+			r.f = F;
+			r.event = EVENT;
+			r.reserved = 0;
+		}
+
+		void flush() const
+		{
+			file.write(reinterpret_cast<char const *>(buffer.data()), used * sizeof(trace_record));
+			file.flush();
+			written += used;
+			used = 0;
+		}
+
+		/** The number of records so far, written or not. */
+		std::size_t size() const { return written + used; }
+
+	private:
+		mutable std::ofstream file;
+		mutable std::vector<trace_record> buffer;
+		mutable std::size_t used, written;
+		std::chrono::steady_clock::time_point const start;
+	};
+
+	constexpr std::array<char, 8> trace_recorder::MAGIC;
+
+
+	/** All the records in the trace file at PATH. */
+	inline std::vector<trace_record> read_trace(std::string const &PATH)
+	{
+		std::ifstream file(PATH, std::ios::binary);
+		if(!file)
+			throw std::runtime_error(PATH + ": cannot be opened.");
+		std::array<char, 8> magic;
+		if(!file.read(magic.data(), magic.size()) || magic != trace_recorder::MAGIC)
+			throw std::runtime_error(PATH + ": not a search trace.");
+
+		std::vector<trace_record> result;
+		trace_record r;
+		while(file.read(reinterpret_cast<char *>(&r), sizeof r))
+			result.push_back(r);
+		if(file.gcount())
+			throw std::runtime_error(PATH + ": truncated record at the end.");
+		return result;
+	}
+
+
+	namespace detail
+	{
+		template <typename State>
+		inline std::uint64_t trace_id(State const &STATE, typename std::enable_if<std::is_default_constructible<std::hash<State>>::value>::type * = nullptr)
+		{
+			return std::hash<State>()(STATE);
+		}
+
+		template <typename State>
+		inline std::uint64_t trace_id(State const &, typename std::enable_if<!std::is_default_constructible<std::hash<State>>::value>::type * = nullptr)
+		{
+			return 0;
+		}
+
+		/**
+		 * The f and h of nodes for the trace, as the cost function of Comparator
+		 * evaluates them.  A comparator says what its cost function is by a
+		 * cost_function typedef; without one, or for a cost function whose
+		 * heuristic is unknown (see detail::cost_heuristic), the values are NaN.
+		 */
+		template <typename Comparator, typename = void>
+		class trace_evaluation
+		{
+		public:
+			template <typename Node>
+			double f(Node const &) const { return std::numeric_limits<double>::quiet_NaN(); }
+
+			template <typename Node>
+			double h(Node const &) const { return std::numeric_limits<double>::quiet_NaN(); }
+		};
+
+		template <typename Comparator>
+		class trace_evaluation<Comparator, typename std::conditional<true, void, typename cost_heuristic<typename Comparator::cost_function>::type>::type>
+		{
+		public:
+			template <typename Node>
+			double f(Node const &NODE) const { return double(COST.f(NODE)); }
+
+			template <typename Node>
+			double h(Node const &NODE) const { return double(HEURISTIC(NODE)); }
+
+		private:
+			typename Comparator::cost_function const COST;
+			typename cost_heuristic<typename Comparator::cost_function>::type const HEURISTIC;
+		};
+
+		/** Record EVENT for NODE, evaluated by EVALUATION, if there is a current trace_recorder. */
+		template <typename Node, typename Evaluation>
+		inline void trace(trace_event const EVENT, Node const &NODE, Evaluation const &EVALUATION)
+		{
+			if(auto const RECORDER = context<trace_recorder>::find())
+				RECORDER->record(EVENT, trace_id(NODE->state()), double(NODE->path_cost()), EVALUATION.h(NODE), EVALUATION.f(NODE));
+		}
+	}
+}
+
+#endif // JSEARCH_TRACE_HPP
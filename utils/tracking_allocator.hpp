@@ -0,0 +1,188 @@
+#ifndef JSEARCH_TRACKING_ALLOCATOR_HPP
+#define JSEARCH_TRACKING_ALLOCATOR_HPP 1
+
+/*
+    tracking_allocator.hpp: Count the memory that each part of a search allocates.
+    Copyright (C) 2026  agent <agent@local>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * The nodes, the frontier's heap, its Map and the closed Set each allocate for
+ * themselves, so to see how much memory a search takes, give each of them a
+ * tracking_allocator tagged with its component, through the usual template
+ * aliases:
+ *
+ *   template <typename T, typename Comparator>
+ *   using PriorityQueue = boost::heap::d_ary_heap<T, ..., boost::heap::allocator<tracking_allocator<T, component::FRONTIER>>>;
+ *
+ *   template <typename Key, typename Value>
+ *   using Map = std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>, tracking_allocator<std::pair<Key const, Value>, component::INDEX>>;
+ *
+ *   template <typename T>
+ *   using ClosedList = std::unordered_set<T, std::hash<T>, std::equal_to<T>, tracking_allocator<T, component::CLOSED>>;
+ *
+ *   template <typename Traits>
+ *   using TrackedNodes = AllocatingNodeCreator<Traits, tracking_allocator<void, component::NODES>>;
+ *
+ * and then count one search by making a memory_statistics its context:
+ *
+ *   memory_statistics const MEMORY;
+ *   context<memory_statistics> const SCOPE(MEMORY);
+ *   auto const COST(best_first_search<PriorityQueue, Comparator, ClosedList, Map>(PROBLEM, path));
+ *   std::cout << MEMORY;
+ *
+ * An allocator belongs to the memory_statistics that was current when it (or
+ * the allocator it was copied from) was made, and one made with none current
+ * counts nothing.  So memory freed after the scope has ended is still counted
+ * against the right search, but the memory_statistics must outlive everything
+ * allocated against it.  Like the context, it belongs to one thread.
+ */
+
+#include "context.hpp"
+
+#include <array>
+#include <memory>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstddef>
+
+
+namespace jsearch
+{
+	/** What the memory is for. */
+	enum class component { NODES, FRONTIER, INDEX, CLOSED, OTHER };
+
+
+	struct allocation_counts
+	{
+		allocation_counts() : bytes(0), peak(0), allocations(0), deallocations(0) {}
+
+		std::size_t bytes; // Allocated and not yet freed.
+		std::size_t peak; // The most that bytes has been.
+		std::size_t allocations, deallocations;
+	};
+
+
+	/** The memory allocated by tracking allocators while this was the current context<memory_statistics>. */
+	class memory_statistics
+	{
+	public:
+		static constexpr std::size_t COMPONENTS = static_cast<std::size_t>(component::OTHER) + 1;
+
+		allocation_counts const &operator[](component const C) const { return components[static_cast<std::size_t>(C)]; }
+
+		/** All components together.  Its peak is the peak of their sum, not the sum of their peaks. */
+		allocation_counts const &total() const { return total_; }
+
+		void allocated(component const C, std::size_t const BYTES) const
+		{
+			add(components[static_cast<std::size_t>(C)], BYTES);
+			add(total_, BYTES);
+		}
+
+		void deallocated(component const C, std::size_t const BYTES) const
+		{
+			subtract(components[static_cast<std::size_t>(C)], BYTES);
+			subtract(total_, BYTES);
+		}
+
+	private:
+		static void add(allocation_counts &counts, std::size_t const BYTES)
+		{
+			counts.bytes += BYTES;
+			counts.peak = std::max(counts.peak, counts.bytes);
+			++counts.allocations;
+		}
+
+		static void subtract(allocation_counts &counts, std::size_t const BYTES)
+		{
+			counts.bytes -= BYTES;
+			++counts.deallocations;
+		}
+
+		mutable std::array<allocation_counts, COMPONENTS> components;
+		mutable allocation_counts total_;
+	};
+
+
+	inline std::ostream &operator<<(std::ostream &stream, memory_statistics const &MEMORY)
+	{
+		static char const *const NAMES[memory_statistics::COMPONENTS + 1] = { "nodes", "frontier", "index", "closed", "other", "total" };
+		stream << std::left << std::setw(10) << "" << std::right << std::setw(14) << "peak bytes" << std::setw(14) << "bytes" << std::setw(14) << "allocations" << "\n";
+		for(std::size_t i(0); i <= memory_statistics::COMPONENTS; ++i)
+		{
+			auto const &COUNTS(i == memory_statistics::COMPONENTS ? MEMORY.total() : MEMORY[static_cast<component>(i)]);
+			if(COUNTS.allocations || i == memory_statistics::COMPONENTS)
+				stream << std::left << std::setw(10) << NAMES[i] << std::right << std::setw(14) << COUNTS.peak << std::setw(14) << COUNTS.bytes << std::setw(14) << COUNTS.allocations << "\n";
+		}
+		return stream;
+	}
+
+
+	/**
+	 * An allocator like std::allocator that counts what it allocates for Component in the current memory_statistics.
+	 */
+	template <typename T, component Component>
+	class tracking_allocator
+	{
+	public:
+		typedef T value_type;
+		typedef T *pointer;
+		typedef T const *const_pointer;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		template <typename U>
+		struct rebind
+		{
+			typedef tracking_allocator<U, Component> other;
+		};
+
+		tracking_allocator() : statistics(context<memory_statistics>::find()) {}
+
+		template <typename U>
+		tracking_allocator(tracking_allocator<U, Component> const &OTHER) : statistics(OTHER.statistics) {}
+
+		T *allocate(std::size_t const N)
+		{
+			T *const RESULT(std::allocator<T>().allocate(N));
+			if(statistics)
+				statistics->allocated(Component, N * sizeof(T));
+			return RESULT;
+		}
+
+		void deallocate(T *const P, std::size_t const N)
+		{
+			if(statistics)
+				statistics->deallocated(Component, N * sizeof(T));
+			std::allocator<T>().deallocate(P, N);
+		}
+
+		template <typename U>
+		bool operator==(tracking_allocator<U, Component> const &OTHER) const { return statistics == OTHER.statistics; }
+
+		template <typename U>
+		bool operator!=(tracking_allocator<U, Component> const &OTHER) const { return statistics != OTHER.statistics; }
+
+	private:
+		template <typename U, component Component_> friend class tracking_allocator;
+
+		memory_statistics const *statistics;
+	};
+}
+
+#endif // JSEARCH_TRACKING_ALLOCATOR_HPP